@@ -0,0 +1,224 @@
+#include "awns.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <new>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "command.hpp"
+#include "gps.hpp"
+#include "navigator.hpp"
+
+/* awns_command is NavCommand under C names, field for field, so it also
+   reads the command channel's payload */
+static_assert(sizeof(awns_command) == sizeof(NavCommand));
+static_assert(offsetof(awns_command, bearing) == offsetof(NavCommand, bearing));
+static_assert(offsetof(awns_command, latitude) ==
+	      offsetof(NavCommand, latitude));
+static_assert(offsetof(awns_command, longitude) ==
+	      offsetof(NavCommand, longitude));
+static_assert(offsetof(awns_command, dest_latitude) ==
+	      offsetof(NavCommand, destLatitude));
+static_assert(offsetof(awns_command, dest_longitude) ==
+	      offsetof(NavCommand, destLongitude));
+static_assert(offsetof(awns_command, distance) ==
+	      offsetof(NavCommand, distance));
+static_assert(offsetof(awns_command, cross_track) ==
+	      offsetof(NavCommand, crossTrack));
+static_assert(offsetof(awns_command, percent) == offsetof(NavCommand, percent));
+static_assert(offsetof(awns_command, waypoint) ==
+	      offsetof(NavCommand, waypoint));
+static_assert(offsetof(awns_command, timestamp) ==
+	      offsetof(NavCommand, timestamp));
+static_assert(offsetof(awns_command, completed) ==
+	      offsetof(NavCommand, completed));
+static_assert(offsetof(awns_command, status) == offsetof(NavCommand, status));
+
+/* Navigator behind the C API. Fixes are pushed rather than read from a
+   position source, so the quiet replay navigator serves */
+struct awns_navigator {
+	ReplayNavigator nav;	   /* Navigator steering from pushed fixes */
+	awns_stats	stats;	   /* Counters since load */
+	bool		loaded;	   /* Flag to mark a mission is loaded */
+	bool		completed; /* Flag to mark the tour has completed */
+};
+
+/* Reset counters for a freshly loaded mission */
+static void reset(awns_navigator *nav) noexcept
+{
+	nav->stats	     = awns_stats{};
+	nav->stats.waypoints = nav->nav.getTour().size();
+	nav->stats.next	     = nav->nav.getNextDest();
+	nav->stats.eta	     = -1.0;
+	nav->loaded	     = true;
+	nav->completed	     = false;
+}
+
+/* ABI version of library */
+uint32_t awns_abi_version(void)
+{
+	return AWNS_ABI_VERSION;
+}
+
+/* Fill 'config' with default settings */
+void awns_default_config(awns_config *config)
+{
+	if (config) {
+		*config = { 5.0, 0, 1, 1, 0 };
+	}
+}
+
+/* Create quiet navigator with 'config', or defaults if null */
+awns_navigator *awns_create(const awns_config *config)
+{
+	awns_config defaults{};
+	awns_default_config(&defaults);
+	const auto &c{ config ? *config : defaults };
+	auto *nav{ new (std::nothrow) awns_navigator{} };
+	if (!nav) {
+		return nullptr;
+	}
+	nav->nav.setVerbose(false);
+	nav->nav.setProximityRadius(c.radius);
+	nav->nav.setKalmanFilter(c.filter);
+	nav->nav.setNavigationFrame(c.frame);
+	nav->nav.setOvershootDetection(c.overshoot);
+	return nav;
+}
+
+/* Destroy navigator */
+void awns_destroy(awns_navigator *nav)
+{
+	delete nav;
+}
+
+/* Load mission from waypoint pairs and optional visiting order */
+int awns_load_mission(awns_navigator *nav, const double *latlon,
+		      size_t count, const size_t *order)
+{
+	if (!nav || !latlon || count < 2) {
+		return AWNS_EINVAL;
+	}
+	try {
+		std::vector<std::pair<double, double> > waypoints(count);
+		for (std::size_t i = 0; i < count; i++) {
+			waypoints[i] = { latlon[2 * i], latlon[2 * i + 1] };
+		}
+		std::vector<std::size_t> tourOrder(count);
+		if (order) {
+			tourOrder.assign(order, order + count);
+		} else {
+			std::iota(tourOrder.begin(), tourOrder.end(), 0);
+		}
+		nav->loaded = false;
+		if (!nav->nav.loadTour(waypoints, tourOrder)) {
+			return AWNS_EINVAL;
+		}
+	} catch (const std::bad_alloc &) {
+		return AWNS_ENOMEM;
+	} catch (const std::exception &) {
+		return AWNS_EINVAL;
+	}
+	reset(nav);
+	return AWNS_OK;
+}
+
+/* Load mission from waypoint CSV in visiting order */
+int awns_load_mission_file(awns_navigator *nav, const char *path)
+{
+	if (!nav || !path) {
+		return AWNS_EINVAL;
+	}
+	try {
+		nav->loaded = false;
+		if (!nav->nav.loadTourFile(path) ||
+		    nav->nav.getTour().size() < 2) {
+			return AWNS_EIO;
+		}
+	} catch (const std::bad_alloc &) {
+		return AWNS_ENOMEM;
+	} catch (const std::exception &) {
+		return AWNS_EIO;
+	}
+	reset(nav);
+	return AWNS_OK;
+}
+
+/* Steer from fix and update counters, without allocating */
+int awns_push_fix(awns_navigator *nav, const awns_fix *fix)
+{
+	if (!nav || !fix || !std::isfinite(fix->latitude) ||
+	    !std::isfinite(fix->longitude)) {
+		return AWNS_EINVAL;
+	}
+	if (!nav->loaded) {
+		return AWNS_ENOTLOADED;
+	}
+	if (nav->completed) {
+		return AWNS_DONE;
+	}
+	auto   start{ std::chrono::steady_clock::now() };
+	GPSFix gpsFix{ fix->latitude, fix->longitude, fix->heading, fix->speed,
+		       fix->time,     fix->epx,	      fix->epy };
+	auto   prev{ nav->nav.getNextDest() };
+	auto   bearing{ nav->nav.steer(gpsFix) };
+	auto   next{ nav->nav.getNextDest() };
+	auto   progress{ nav->nav.getProgress() };
+	auto   end{ std::chrono::steady_clock::now() };
+	/* Update counters */
+	auto &stats{ nav->stats };
+	auto  step{ static_cast<std::uint64_t>(
+		 std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+			 .count()) };
+	stats.fixes++;
+	stats.arrivals += next != prev;
+	stats.next	    = next;
+	stats.last_step_ns = step;
+	stats.max_step_ns  = std::max(stats.max_step_ns, step);
+	stats.remaining	   = progress.remaining;
+	stats.eta	   = progress.eta;
+	if (!bearing) {
+		/* Arrival back at the starting position ends the tour */
+		stats.arrivals++;
+		stats.completed = 1;
+		nav->completed	= true;
+		return AWNS_DONE;
+	}
+	return AWNS_OK;
+}
+
+/* Copy current command */
+int awns_get_command(const awns_navigator *nav, awns_command *command)
+{
+	if (!nav || !command) {
+		return AWNS_EINVAL;
+	}
+	if (!nav->loaded) {
+		return AWNS_ENOTLOADED;
+	}
+	NavCommand current{ nav->nav.getCommand() };
+	current.completed = nav->completed;
+	std::memcpy(command, &current, sizeof(current));
+	return AWNS_OK;
+}
+
+/* Copy counters */
+int awns_get_stats(const awns_navigator *nav, awns_stats *stats)
+{
+	if (!nav || !stats) {
+		return AWNS_EINVAL;
+	}
+	if (!nav->loaded) {
+		return AWNS_ENOTLOADED;
+	}
+	*stats = nav->stats;
+	return AWNS_OK;
+}
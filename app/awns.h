@@ -0,0 +1,133 @@
+#ifndef AWNS_H
+#define AWNS_H
+
+/* C API of libawns, for steering from a controller's own control loop in
+   C, Rust, Python ctypes or any other language with a C FFI. Only
+   awns_create(), the awns_load_*() calls and a mission's first fix in the
+   local navigation frame allocate; awns_push_fix(), awns_get_command() and
+   awns_get_stats() otherwise only copy into caller-provided structs. A
+   navigator is not thread-safe, so use one per thread */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define AWNS_API __attribute__((visibility("default")))
+#else
+#define AWNS_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever a struct or signature below changes */
+#define AWNS_ABI_VERSION 1
+
+/* Return codes */
+enum awns_status {
+	AWNS_OK		= 0,  /* Success */
+	AWNS_DONE	= 1,  /* Tour has completed */
+	AWNS_EINVAL	= -1, /* Invalid argument */
+	AWNS_ENOTLOADED = -2, /* No mission loaded */
+	AWNS_ENOMEM	= -3, /* Out of memory */
+	AWNS_EIO	= -4  /* Mission file could not be read */
+};
+
+/* Opaque navigator */
+typedef struct awns_navigator awns_navigator;
+
+/* Navigator settings, see awns_default_config() */
+typedef struct awns_config {
+	double	 radius;    /* Proximity radius in meters, at least 1 */
+	uint32_t filter;    /* Nonzero to Kalman filter fixes */
+	uint32_t frame;	    /* Nonzero for local navigation frame */
+	uint32_t overshoot; /* Nonzero for overshoot detection */
+	uint32_t reserved;  /* Zero */
+} awns_config;
+
+/* GPS fix. Set unknown speed, heading or error estimates to NaN */
+typedef struct awns_fix {
+	double latitude;  /* Degrees */
+	double longitude; /* Degrees */
+	double heading;	  /* Degrees from true North */
+	double speed;	  /* Meters per second over ground */
+	double time;	  /* Seconds since Unix epoch */
+	double epx;	  /* Longitude error estimate in meters */
+	double epy;	  /* Latitude error estimate in meters */
+} awns_fix;
+
+/* Navigation command, laid out as the shared-memory channel's and binary
+   stream's command */
+typedef struct awns_command {
+	double	 bearing;	 /* Degrees from true North */
+	double	 latitude;	 /* Current position */
+	double	 longitude;	 /* Current position */
+	double	 dest_latitude;	 /* Next destination */
+	double	 dest_longitude; /* Next destination */
+	double	 distance;	 /* Meters to next destination */
+	double	 cross_track;	 /* Meters off current leg, positive right of
+				    track */
+	double	 percent;	 /* Percent of tour length completed */
+	uint64_t waypoint;	 /* CSV index of next destination */
+	int64_t	 timestamp;	 /* Nanoseconds since Unix epoch */
+	uint32_t completed;	 /* Nonzero once tour has completed */
+	uint32_t status;	 /* Zero, or 1 on the command channel once the GPS
+				    signal is lost */
+} awns_command;
+
+/* Counters since the mission was loaded */
+typedef struct awns_stats {
+	uint64_t fixes;	       /* Fixes pushed */
+	uint64_t arrivals;     /* Waypoints reached */
+	uint64_t waypoints;    /* Waypoints in tour */
+	uint64_t next;	       /* Tour index of next destination */
+	uint64_t last_step_ns; /* Time spent in last awns_push_fix() */
+	uint64_t max_step_ns;  /* Longest awns_push_fix() */
+	double	 remaining;    /* Meters left in tour */
+	double	 eta;	       /* Seconds to completion, negative if unknown */
+	uint32_t completed;    /* Nonzero once tour has completed */
+	uint32_t reserved;     /* Zero */
+} awns_stats;
+
+/* ABI version of the loaded library, compare with AWNS_ABI_VERSION */
+AWNS_API uint32_t awns_abi_version(void);
+
+/* Fill 'config' with defaults: 5 m radius, overshoot detection and local
+   navigation frame on, filter off */
+AWNS_API void awns_default_config(awns_config *config);
+
+/* Create navigator with 'config', or defaults if NULL */
+/* Returns NULL on failure */
+AWNS_API awns_navigator *awns_create(const awns_config *config);
+
+/* Destroy navigator, which may be NULL */
+AWNS_API void awns_destroy(awns_navigator *nav);
+
+/* Load mission of 'count' waypoints as 'latlon' pairs {lat0, lon0, lat1,
+   lon1, ...} in CSV order. 'order' is the visiting order as indices into
+   the waypoints starting at the system's starting position, or NULL if
+   already in visiting order */
+AWNS_API int awns_load_mission(awns_navigator *nav, const double *latlon,
+			       size_t count, const size_t *order);
+
+/* Load mission from a waypoint CSV already in visiting order, such as a
+   route written by 'awns-rpi5 mtsp' */
+AWNS_API int awns_load_mission_file(awns_navigator *nav, const char *path);
+
+/* Steer from 'fix' */
+/* Returns AWNS_OK, or AWNS_DONE once the tour has completed */
+AWNS_API int awns_push_fix(awns_navigator *nav, const awns_fix *fix);
+
+/* Copy current command into 'command' */
+AWNS_API int awns_get_command(const awns_navigator *nav,
+			      awns_command	   *command);
+
+/* Copy counters into 'stats' */
+AWNS_API int awns_get_stats(const awns_navigator *nav, awns_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AWNS_H */
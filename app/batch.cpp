@@ -0,0 +1,245 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "navigator.hpp"
+#include "simulator.hpp"
+
+/* Constructor with default grid */
+/* Defaults cover noiseless, white and slowly wandering 3 m error, walking to
+   road speeds, tight to loose proximity radii and 5 Hz to 0.5 Hz ticks */
+BatchEvaluator::BatchEvaluator(void)
+	: noiseModels_{ { "none", 0.0, 0.0 },
+			{ "white-3m", 3.0, 0.0 },
+			{ "markov-3m", 3.0, 60.0 } },
+	  velocities_{ 2.0, 5.0, 10.0, 20.0 },
+	  radii_{ 5.0, 10.0, 20.0 },
+	  ticks_{ 0.2, 1.0, 2.0 },
+	  trials_{ 4 }
+{
+}
+
+/* Add solved mission, 'order' being its visiting order into 'waypoints' */
+void BatchEvaluator::addMission(std::string			      name,
+				std::vector<std::pair<double, double> > waypoints,
+				std::vector<std::size_t>		order)
+{
+	missions_.push_back(
+		{ std::move(name), std::move(waypoints), std::move(order) });
+}
+
+/* Setters for grid axes, empty axes are ignored */
+void BatchEvaluator::setNoiseModels(std::vector<NoiseModel> models)
+{
+	if (!models.empty()) {
+		noiseModels_ = std::move(models);
+	}
+}
+
+void BatchEvaluator::setVelocities(std::vector<double> velocities)
+{
+	if (!velocities.empty()) {
+		velocities_ = std::move(velocities);
+	}
+}
+
+void BatchEvaluator::setRadii(std::vector<double> radii)
+{
+	if (!radii.empty()) {
+		radii_ = std::move(radii);
+	}
+}
+
+void BatchEvaluator::setTicks(std::vector<double> ticks)
+{
+	if (!ticks.empty()) {
+		ticks_ = std::move(ticks);
+	}
+}
+
+/* Parse noise model 'name': none, white-SIGMAm for white error or
+   markov-SIGMAm for error wandering over 60 s, as the default grid's */
+/* Returns empty if 'name' is not a noise model */
+std::optional<NoiseModel> BatchEvaluator::noiseModel(const std::string &name)
+{
+	if (name == "none") {
+		return NoiseModel{ name, 0.0, 0.0 };
+	}
+	for (auto [prefix, tau] : { std::pair{ std::string{ "white-" }, 0.0 },
+				    std::pair{ std::string{ "markov-" },
+					       60.0 } }) {
+		if (!name.starts_with(prefix) || !name.ends_with('m')) {
+			continue;
+		}
+		std::string sigma{ name.substr(
+			prefix.size(), name.size() - prefix.size() - 1) };
+		std::size_t pos{ 0 };
+		double	    value{ 0.0 };
+		try {
+			value = std::stod(sigma, &pos);
+		} catch (const std::exception &) {
+			return std::nullopt;
+		}
+		if (pos != sigma.size() || !std::isfinite(value) ||
+		    value < 0.0) {
+			return std::nullopt;
+		}
+		return NoiseModel{ name, value, tau };
+	}
+	return std::nullopt;
+}
+
+/* Setter for trials per grid point, at least one */
+void BatchEvaluator::setTrials(std::size_t trials) noexcept
+{
+	trials_ = std::max<std::size_t>(trials, 1);
+}
+
+/* Number of simulations run() will perform */
+std::size_t BatchEvaluator::jobCount(void) const noexcept
+{
+	return missions_.size() * noiseModels_.size() * velocities_.size() *
+	       radii_.size() * ticks_.size() * 2 * trials_;
+}
+
+/* Cartesian product of grid axes, with and without Kalman filtering */
+std::vector<BatchParams> BatchEvaluator::grid(void) const
+{
+	std::vector<BatchParams> points{};
+	for (const auto &noise : noiseModels_) {
+		for (double velocity : velocities_) {
+			for (double radius : radii_) {
+				for (double tick : ticks_) {
+					for (bool filter : { false, true }) {
+						points.push_back({ noise,
+								   velocity,
+								   radius, tick,
+								   filter });
+					}
+				}
+			}
+		}
+	}
+	return points;
+}
+
+/* Simulate one trial of 'mission' at grid point 'params' */
+/* Each trial gets its own quiet navigator, so trials share no state */
+MissionReport BatchEvaluator::simulate(const Mission	 &mission,
+				       const BatchParams &params,
+				       std::uint64_t	  seed) const
+{
+	ReplayNavigator nav{};
+	nav.setVerbose(false);
+	nav.setProximityRadius(params.radius);
+	nav.setNavigationFrame(true);
+	nav.setKalmanFilter(params.filter);
+	nav.loadTour(mission.waypoints, mission.order);
+	SyntheticGPS gps{ nav.getTour().at(0) };
+	gps.setNoise(params.noise.sigma, params.noise.tau, seed);
+	Simulator sim{ nav, gps };
+	sim.setVelocity(params.velocity);
+	sim.setTick(params.tick);
+	return sim.run();
+}
+
+/* Run every trial of every mission at every grid point on 'threads' worker
+   threads (all cores if 0) and aggregate trials per mission and grid point */
+std::vector<BatchRow> BatchEvaluator::run(unsigned threads)
+{
+	/* Per trial outcome, written by exactly one worker */
+	struct Outcome {
+		bool	completed;
+		double	missed;
+		double	overhead;
+		double	time;
+	};
+	auto			 points{ grid() };
+	std::size_t		 rows{ missions_.size() * points.size() };
+	std::vector<Outcome>	 outcomes(rows * trials_);
+	std::atomic<std::size_t> nextJob{ 0 };
+	/* Workers claim jobs until none remain */
+	auto worker{ [&](void) {
+		for (std::size_t j = nextJob++; j < outcomes.size();
+		     j		   = nextJob++) {
+			std::size_t row{ j / trials_ };
+			const auto &mission{ missions_[row / points.size()] };
+			const auto &params{ points[row % points.size()] };
+			/* SplitMix64 of job index for reproducible seeds */
+			std::uint64_t z{ (j + 1) * 0x9E3779B97F4A7C15ULL };
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			auto report{ simulate(mission, params, z ^ (z >> 31)) };
+			outcomes[j] = {
+				report.completed,
+				static_cast<double>(mission.waypoints.size() -
+						    report.arrivals.size()),
+				report.distance / report.tourLength - 1.0,
+				report.time
+			};
+		}
+	} };
+	if (!threads) {
+		threads = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+	std::vector<std::jthread> pool{};
+	for (unsigned i = 0; i < threads; i++) {
+		pool.emplace_back(worker);
+	}
+	pool.clear(); /* Join workers */
+	/* Aggregate trials into rows */
+	std::vector<BatchRow> summary{};
+	summary.reserve(rows);
+	for (std::size_t row = 0; row < rows; row++) {
+		BatchRow r{ missions_[row / points.size()].name,
+			    points[row % points.size()],
+			    trials_,
+			    0.0,
+			    0.0,
+			    0.0,
+			    0.0 };
+		for (std::size_t t = 0; t < trials_; t++) {
+			const auto &o{ outcomes[row * trials_ + t] };
+			r.completionRate += o.completed;
+			r.missedWaypoints += o.missed;
+			r.distanceOverhead += o.overhead;
+			r.time += o.time;
+		}
+		r.completionRate /= trials_;
+		r.missedWaypoints /= trials_;
+		r.distanceOverhead /= trials_;
+		r.time /= trials_;
+		summary.push_back(std::move(r));
+	}
+	return summary;
+}
+
+/* Write summary table as CSV */
+void BatchEvaluator::writeSummary(std::ostream		       &out,
+				  const std::vector<BatchRow> &rows)
+{
+	out << "mission,noise,velocity,radius,tick,filter,trials,"
+	       "completion_rate,missed_waypoints,distance_overhead,time\n";
+	for (const auto &r : rows) {
+		out << r.mission << "," << r.params.noise.name << ","
+		    << r.params.velocity << "," << r.params.radius << ","
+		    << r.params.tick << "," << r.params.filter << ","
+		    << r.trials << "," << std::fixed << std::setprecision(3)
+		    << r.completionRate << "," << r.missedWaypoints << ","
+		    << r.distanceOverhead << "," << std::setprecision(1)
+		    << r.time << "\n"
+		    << std::defaultfloat << std::setprecision(6);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "simulator.hpp"
+
+/* GPS noise model for simulated fixes, see SyntheticGPS::setNoise() */
+struct NoiseModel {
+	std::string name;  /* Label for summary table */
+	double	    sigma; /* Standard deviation in meters */
+	double	    tau;   /* Correlation time in seconds, 0 for white */
+};
+
+/* One point of the parameter grid */
+struct BatchParams {
+	NoiseModel noise;    /* GPS noise model */
+	double	   velocity; /* Vehicle speed in meters per second */
+	double	   radius;   /* Proximity radius in meters */
+	double	   tick;     /* Seconds between navigation ticks */
+	bool	   filter;   /* Whether fixes are Kalman filtered */
+};
+
+/* Aggregate of all trials of one mission at one grid point */
+struct BatchRow {
+	std::string mission;	      /* Mission name */
+	BatchParams params;	      /* Grid point */
+	std::size_t trials;	      /* Number of trials */
+	double	    completionRate;   /* Fraction of trials completing tour */
+	double	    missedWaypoints;  /* Mean waypoints never reached */
+	double	    distanceOverhead; /* Mean distance driven over tour
+					 length, as a fraction */
+	double	    time;	      /* Mean mission time in seconds */
+};
+
+/* Monte Carlo evaluator sweeping a grid of navigation parameters over solved
+   missions with the offline Simulator, in parallel across cores */
+class BatchEvaluator {
+    public:
+	BatchEvaluator(void);
+
+	void addMission(std::string, std::vector<std::pair<double, double> >,
+			std::vector<std::size_t>);
+	void setNoiseModels(std::vector<NoiseModel>);
+	void setVelocities(std::vector<double>);
+	void setRadii(std::vector<double>);
+	void setTicks(std::vector<double>);
+	void setTrials(std::size_t) noexcept;
+	std::size_t	      jobCount(void) const noexcept;
+	std::vector<BatchRow> run(unsigned);
+
+	static void writeSummary(std::ostream &, const std::vector<BatchRow> &);
+	static std::optional<NoiseModel> noiseModel(const std::string &);
+
+    private:
+	struct Mission {
+		std::string			       name;
+		std::vector<std::pair<double, double> > waypoints;
+		std::vector<std::size_t>	       order;
+	};
+
+	std::vector<Mission>	 missions_;   /* Solved missions */
+	std::vector<NoiseModel> noiseModels_; /* Grid axis: GPS noise */
+	std::vector<double>	 velocities_; /* Grid axis: speed */
+	std::vector<double>	 radii_;      /* Grid axis: proximity radius */
+	std::vector<double>	 ticks_;      /* Grid axis: tick period */
+	std::size_t		 trials_;     /* Trials per grid point */
+
+	std::vector<BatchParams> grid(void) const;
+	MissionReport simulate(const Mission &, const BatchParams &,
+			       std::uint64_t) const;
+};
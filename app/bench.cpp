@@ -0,0 +1,221 @@
+#include "bench.hpp"
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "concorde.hpp"
+#include "generator.hpp"
+#include "heuristic.hpp"
+
+/* Constructor with defaults */
+/* Defaults cover every shape from 10 to 10000 waypoints with the builtin
+   solver, three runs each */
+SolveBenchmark::SolveBenchmark(void)
+	: shapes_{ MissionGenerator::shapes() },
+	  sizes_{ 10, 100, 1000, 10000 },
+	  backends_{ ConcordeTSPSolver::builtinSolver },
+	  repeats_{ 3 },
+	  seed_{ 1 },
+	  timeout_{ 300000 },
+	  turnPenalty_{ 0.0 }
+{
+}
+
+/* Setters for benchmark axes, empty axes are ignored */
+void SolveBenchmark::setShapes(std::vector<std::string> shapes)
+{
+	if (!shapes.empty()) {
+		shapes_ = std::move(shapes);
+	}
+}
+
+void SolveBenchmark::setSizes(std::vector<std::size_t> sizes)
+{
+	if (!sizes.empty()) {
+		sizes_ = std::move(sizes);
+	}
+}
+
+void SolveBenchmark::setBackends(std::vector<std::string> backends)
+{
+	if (!backends.empty()) {
+		backends_ = std::move(backends);
+	}
+}
+
+/* Setter for runs per shape, size and backend, at least one */
+void SolveBenchmark::setRepeats(std::size_t repeats) noexcept
+{
+	repeats_ = std::max<std::size_t>(repeats, 1);
+}
+
+/* Setter for mission generator seed, every run of a shape and size solves
+   the same mission */
+void SolveBenchmark::setSeed(std::uint64_t seed) noexcept
+{
+	seed_ = seed;
+}
+
+/* Setter for deadline of each solve, 0 for none */
+void SolveBenchmark::setTimeout(std::chrono::milliseconds timeout) noexcept
+{
+	timeout_ = timeout;
+}
+
+/* Setter for cluster-decomposed solving of every run, empty to solve
+   flat */
+void SolveBenchmark::setClusters(std::optional<std::size_t> clusters) noexcept
+{
+	clusters_ = clusters;
+}
+
+/* Setter for turn penalty of every run, which is also charged in each
+   row's turn cost */
+void SolveBenchmark::setTurnPenalty(double penalty) noexcept
+{
+	turnPenalty_ = std::max(penalty, 0.0);
+}
+
+/* Number of runs run() will perform */
+std::size_t SolveBenchmark::jobCount(void) const noexcept
+{
+	return shapes_.size() * sizes_.size() * backends_.size() * repeats_;
+}
+
+/* Run every shape, size and backend 'repeats_' times, by increasing size so
+   the table fills in cheapest first */
+/* 'progress' is called with each row as it completes */
+std::vector<BenchRow>
+SolveBenchmark::run(const std::function<void(const BenchRow &)> &progress)
+{
+	std::vector<BenchRow> rows{};
+	for (std::size_t size : sizes_) {
+		for (const auto &shape : shapes_) {
+			for (const auto &backend : backends_) {
+				for (std::size_t k = 1; k <= repeats_; k++) {
+					rows.push_back(
+						measure(shape, size, backend, k));
+					if (progress) {
+						progress(rows.back());
+					}
+				}
+			}
+		}
+	}
+	return rows;
+}
+
+/* Generate and solve one mission in a forked worker and collect its wall
+   time, tour length and peak memory */
+BenchRow SolveBenchmark::measure(const std::string &shape, std::size_t size,
+				 const std::string &backend,
+				 std::size_t	    run) const
+{
+	/* What the worker reports back over a pipe */
+	struct Outcome {
+		bool   solved;	 /* Whether a full tour came back */
+		double seconds;	 /* Wall time to solve */
+		double length;	 /* Tour length in meters */
+		double turn;	 /* Turn cost in meters */
+		long   solverRss; /* Peak KiB of solver's own process */
+	};
+	BenchRow row{ shape, size, backend, run, "failed", 0.0, 0, 0.0, 0.0 };
+	int	 fds[2];
+	if (pipe2(fds, O_CLOEXEC) < 0) {
+		return row;
+	}
+	pid_t pid{ fork() };
+	if (pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return row;
+	}
+	if (!pid) { /* Worker */
+		close(fds[0]);
+		Outcome		 out{ false, 0.0, 0.0, 0.0, 0 };
+		MissionGenerator generator{ seed_ };
+		auto		 waypoints{ generator.generate(shape, size) };
+		/* Solve end to end as 'solve' does, minus file output */
+		ConcordeTSPSolver solver{};
+		solver.setVerbose(false);
+		solver.setSolver(backend);
+		solver.setTimeout(timeout_);
+		solver.setClusters(clusters_);
+		solver.setTurnPenalty(turnPenalty_);
+		solver.setCSVFile(shape + "_" + std::to_string(size) + ".csv");
+		solver.setWaypoints(waypoints);
+		auto start{ std::chrono::steady_clock::now() };
+		solver.writeTSPFile();
+		solver.solveTSP();
+		solver.readTSPSolution();
+		auto end{ std::chrono::steady_clock::now() };
+		out.seconds = std::chrono::duration<double>(end - start).count();
+		const auto &order{ solver.getTourOrder() };
+		out.solved  = !waypoints.empty() && order.size() == waypoints.size();
+		if (out.solved) {
+			out.length = TourHeuristic::tourLength(waypoints, order);
+			out.turn   = TourHeuristic::turnCost(waypoints, order,
+								 turnPenalty_);
+		}
+		rusage usage{};
+		getrusage(RUSAGE_CHILDREN, &usage);
+		out.solverRss = usage.ru_maxrss;
+		bool sent{ write(fds[1], &out, sizeof(out)) == sizeof(out) };
+		_exit(sent ? 0 : 1);
+	}
+	close(fds[1]);
+	Outcome out{ false, 0.0, 0.0, 0.0, 0 };
+	ssize_t got{};
+	do {
+		got = read(fds[0], &out, sizeof(out));
+	} while (got < 0 && errno == EINTR);
+	close(fds[0]);
+	int    status{ 0 };
+	rusage usage{};
+	while (wait4(pid, &status, 0, &usage) < 0 && errno == EINTR) {
+	}
+	if (got != sizeof(out)) { /* Worker died */
+		return row;
+	}
+	/* A deadline that cut the solve short makes the result partial */
+	bool late{ timeout_.count() &&
+		   out.seconds >= std::chrono::duration<double>(timeout_).count() };
+	row.status  = late ? "timeout" : out.solved ? "ok" : "failed";
+	row.seconds = out.seconds;
+	row.rss	    = std::max(usage.ru_maxrss, out.solverRss);
+	row.length  = out.length;
+	row.turn    = out.turn;
+	return row;
+}
+
+/* Write CSV header of benchmark table to 'out' */
+void SolveBenchmark::writeHeader(std::ostream &out)
+{
+	out << "shape,size,backend,run,status,seconds,peak_rss_kib,length_m,"
+	       "turn_cost_m\n";
+}
+
+/* Write 'row' of benchmark table as CSV to 'out' */
+void SolveBenchmark::writeRow(std::ostream &out, const BenchRow &row)
+{
+	out << row.shape << "," << row.size << "," << row.backend << ","
+	    << row.run << "," << row.status << "," << std::fixed
+	    << std::setprecision(6) << row.seconds << "," << row.rss << ","
+	    << std::setprecision(1) << row.length << "," << row.turn << "\n"
+	    << std::defaultfloat << std::setprecision(6);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* Outcome of one benchmark run */
+struct BenchRow {
+	std::string shape;   /* Generated mission shape */
+	std::size_t size;    /* Waypoints including starting position */
+	std::string backend; /* Solver, see ConcordeTSPSolver::setSolver() */
+	std::size_t run;     /* Repeat number from 1 */
+	std::string status;  /* "ok", "timeout" or "failed" */
+	double	    seconds; /* Wall time to solve */
+	long	    rss;     /* Peak resident set in KiB of worker or solver
+				process, whichever is larger */
+	double	    length;  /* Tour length in meters, 0 unless solved */
+	double	    turn;    /* Turn cost in meters at the turn penalty, 0
+				unless solved */
+};
+
+/* End-to-end solver benchmark over generated missions of growing size. Each
+   run generates its mission and solves it through ConcordeTSPSolver in a
+   forked worker, so peak memory is measured per run and a crashing or
+   runaway solver cannot take the benchmark down. Runs are sequential so
+   they do not compete for cores or memory bandwidth */
+class SolveBenchmark {
+    public:
+	SolveBenchmark(void);
+
+	void	    setShapes(std::vector<std::string>);
+	void	    setSizes(std::vector<std::size_t>);
+	void	    setBackends(std::vector<std::string>);
+	void	    setRepeats(std::size_t) noexcept;
+	void	    setSeed(std::uint64_t) noexcept;
+	void	    setTimeout(std::chrono::milliseconds) noexcept;
+	void	    setClusters(std::optional<std::size_t>) noexcept;
+	void	    setTurnPenalty(double) noexcept;
+	std::size_t jobCount(void) const noexcept;
+	std::vector<BenchRow> run(const std::function<void(const BenchRow &)> &);
+
+	static void writeHeader(std::ostream &);
+	static void writeRow(std::ostream &, const BenchRow &);
+
+    private:
+	std::vector<std::string> shapes_;   /* Mission shapes */
+	std::vector<std::size_t> sizes_;    /* Mission sizes */
+	std::vector<std::string> backends_; /* Solvers */
+	std::size_t		 repeats_;  /* Runs per shape, size and
+					       backend */
+	std::uint64_t		 seed_;	    /* Mission generator seed */
+	std::chrono::milliseconds timeout_; /* Deadline per solve, 0 for
+					       none */
+	std::optional<std::size_t> clusters_; /* Decomposition, see
+						 ConcordeTSPSolver::
+						 setClusters() */
+	double turnPenalty_; /* See ConcordeTSPSolver::setTurnPenalty() */
+
+	BenchRow measure(const std::string &, std::size_t, const std::string &,
+			 std::size_t) const;
+};
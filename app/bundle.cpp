@@ -0,0 +1,290 @@
+#include "bundle.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "navframe.hpp"
+#include "route.hpp"
+
+/* Destructor */
+MissionBundle::~MissionBundle(void)
+{
+	close();
+}
+
+/* Bytes of bundle for 'count' waypoints */
+std::size_t MissionBundle::fileSize(std::size_t count) noexcept
+{
+	return sizeof(Header) + count * 2 * sizeof(double) +
+	       2 * count * sizeof(std::uint64_t) +
+	       count * 2 * sizeof(double) + count * sizeof(LegTable::Leg) +
+	       (count + 1) * sizeof(double);
+}
+
+/* FNV-1a hash of 'size' bytes of bundle 'bytes', taking the header's checksum
+   as zero */
+std::uint64_t MissionBundle::checksum(const unsigned char *bytes,
+				      std::size_t	   size) noexcept
+{
+	constexpr std::size_t field{ offsetof(Header, checksum) };
+	std::uint64_t	      hash{ 0xcbf29ce484222325 };
+	for (std::size_t i = 0; i < size; i++) {
+		bool zeroed{ i >= field && i < field + sizeof(std::uint64_t) };
+		hash ^= zeroed ? 0 : bytes[i];
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+/* Point section pointers into mapping 'map' of 'size' bytes */
+void MissionBundle::bind(void *map, std::size_t size) noexcept
+{
+	auto *bytes{ static_cast<unsigned char *>(map) };
+	map_	    = map;
+	size_	    = size;
+	header_	    = static_cast<const Header *>(map);
+	auto count{ header_->count };
+	waypoints_  = reinterpret_cast<const double *>(bytes + sizeof(Header));
+	csvRows_    = reinterpret_cast<const std::uint64_t *>(waypoints_ +
+							      2 * count);
+	order_	    = csvRows_ + count;
+	projected_  = reinterpret_cast<const double *>(order_ + count);
+	legs_	    = reinterpret_cast<const LegTable::Leg *>(projected_ +
+							      2 * count);
+	cumulative_ = reinterpret_cast<const double *>(legs_ + count);
+}
+
+/* Compile bundle 'path' for a solved mission read from 'csvFile' */
+/* 'waypoints' are as solved, 'order' is the solved visiting order and
+   'csvRows' the CSV row of each waypoint. The file is built beside 'path'
+   and renamed over it, so an existing bundle is only ever replaced by a
+   complete one. Returns false on failure, or if 'csvFile' is too long to
+   store */
+bool MissionBundle::write(const std::filesystem::path		    &path,
+			  const std::filesystem::path		    &csvFile,
+			  const std::vector<std::pair<double, double> > &waypoints,
+			  const std::vector<std::size_t> &order,
+			  const std::vector<std::size_t> &csvRows)
+{
+	std::size_t count{ order.size() };
+	if (count < 2 || waypoints.size() != count ||
+	    csvRows.size() != count) {
+		std::cerr << "Error: cannot compile incomplete mission.\n";
+		return false;
+	}
+	/* The path names the log file on 'run --bundle', so it must fit whole */
+	if (csvFile.native().size() >= sizeof(Header::csvFile)) {
+		std::cerr << "Error: CSV path " << csvFile
+			  << " is too long for a mission bundle, at most "
+			  << sizeof(Header::csvFile) - 1 << " bytes.\n";
+		return false;
+	}
+	/* Derive what navigation would build at start */
+	std::vector<std::pair<double, double> > tour(count);
+	for (std::size_t i = 0; i < count; i++) {
+		tour[i] = waypoints.at(order[i]);
+	}
+	LegTable legs{};
+	legs.build(tour);
+	LocalFrame frame{};
+	frame.anchor(tour[0]);
+	frame.project(tour);
+	/* Write file through a mapping */
+	std::error_code ec{};
+	std::filesystem::create_directories(path.parent_path(), ec);
+	std::filesystem::path tmp{ path.string() + ".tmp" };
+	std::size_t	      size{ fileSize(count) };
+	int fd{ ::open(tmp.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC,
+		       0644) };
+	if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) < 0) {
+		std::cerr << "Error: cannot create mission bundle " << tmp
+			  << ".\n";
+		if (fd >= 0) {
+			::close(fd);
+		}
+		return false;
+	}
+	void *map{ mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+			0) };
+	::close(fd);
+	if (map == MAP_FAILED) {
+		std::cerr << "Error: cannot map mission bundle " << tmp << ".\n";
+		return false;
+	}
+	auto *header{ new (map) Header{} };
+	header->magic	  = magicValue;
+	header->version	  = versionValue;
+	header->count	  = count;
+	header->anchorLat = tour[0].first;
+	header->anchorLon = tour[0].second;
+	header->length	  = legs.total();
+	std::strncpy(header->csvFile, csvFile.c_str(),
+		     sizeof(header->csvFile) - 1);
+	auto *bytes{ static_cast<unsigned char *>(map) };
+	auto *out{ reinterpret_cast<double *>(bytes + sizeof(Header)) };
+	for (const auto &[lat, lon] : waypoints) {
+		*out++ = lat;
+		*out++ = lon;
+	}
+	auto *index{ reinterpret_cast<std::uint64_t *>(out) };
+	for (std::size_t row : csvRows) {
+		*index++ = row;
+	}
+	for (std::size_t idx : order) {
+		*index++ = idx;
+	}
+	out = reinterpret_cast<double *>(index);
+	for (std::size_t i = 0; i < count; i++) {
+		*out++ = frame.waypoint(i).first;
+		*out++ = frame.waypoint(i).second;
+	}
+	auto *leg{ std::copy(legs.legs().begin(), legs.legs().end(),
+			     reinterpret_cast<LegTable::Leg *>(out)) };
+	std::copy(legs.cumulative().begin(), legs.cumulative().end(),
+		  reinterpret_cast<double *>(leg));
+	header->checksum = checksum(bytes, size);
+	msync(map, size, MS_SYNC);
+	munmap(map, size);
+	std::filesystem::rename(tmp, path, ec);
+	if (ec) {
+		std::cerr << "Error: cannot write mission bundle " << path
+			  << ".\n";
+		return false;
+	}
+	return true;
+}
+
+/* Map bundle 'path' read-only */
+/* Returns false if it is missing, from another layout version or fails its
+   checksum */
+bool MissionBundle::open(const std::filesystem::path &path)
+{
+	close();
+	int fd{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st {};
+	if (fstat(fd, &st) < 0 ||
+	    static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+	auto  size{ static_cast<std::size_t>(st.st_size) };
+	void *map{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE,
+			fd, 0) };
+	::close(fd);
+	if (map == MAP_FAILED) {
+		return false;
+	}
+	const auto *header{ static_cast<const Header *>(map) };
+	if (header->magic != magicValue || header->version != versionValue ||
+	    header->count < 2 || size != fileSize(header->count) ||
+	    header->checksum !=
+		    checksum(static_cast<const unsigned char *>(map), size)) {
+		munmap(map, size);
+		return false;
+	}
+	bind(map, size);
+	return true;
+}
+
+/* Unmap bundle, if open */
+void MissionBundle::close(void) noexcept
+{
+	if (map_) {
+		munmap(map_, size_);
+		map_	    = nullptr;
+		size_	    = 0;
+		header_	    = nullptr;
+		waypoints_  = nullptr;
+		csvRows_    = nullptr;
+		order_	    = nullptr;
+		projected_  = nullptr;
+		legs_	    = nullptr;
+		cumulative_ = nullptr;
+	}
+}
+
+/* Whether bundle is open */
+bool MissionBundle::isOpen(void) const noexcept
+{
+	return map_;
+}
+
+/* Waypoints as solved */
+std::vector<std::pair<double, double> > MissionBundle::waypoints(void) const
+{
+	std::vector<std::pair<double, double> > waypoints(header_->count);
+	for (std::size_t i = 0; i < waypoints.size(); i++) {
+		waypoints[i] = { waypoints_[2 * i], waypoints_[2 * i + 1] };
+	}
+	return waypoints;
+}
+
+/* Solved visiting order */
+std::vector<std::size_t> MissionBundle::order(void) const
+{
+	return { order_, order_ + header_->count };
+}
+
+/* CSV row of each waypoint */
+std::vector<std::size_t> MissionBundle::csvRows(void) const
+{
+	return { csvRows_, csvRows_ + header_->count };
+}
+
+/* Mission CSV path */
+std::filesystem::path MissionBundle::csvFile(void) const
+{
+	return std::string{ header_->csvFile,
+			    strnlen(header_->csvFile,
+				    sizeof(header_->csvFile)) };
+}
+
+/* Anchor of projected tour, its first waypoint */
+std::pair<double, double> MissionBundle::anchor(void) const noexcept
+{
+	return { header_->anchorLat, header_->anchorLon };
+}
+
+/* Tour length in meters */
+double MissionBundle::length(void) const noexcept
+{
+	return header_->length;
+}
+
+/* Tour projected about anchor(), see LocalFrame */
+std::vector<LocalFrame::Point> MissionBundle::projected(void) const
+{
+	std::vector<LocalFrame::Point> points(header_->count);
+	for (std::size_t i = 0; i < points.size(); i++) {
+		points[i] = { projected_[2 * i], projected_[2 * i + 1] };
+	}
+	return points;
+}
+
+/* Legs of tour, see LegTable */
+std::span<const LegTable::Leg> MissionBundle::legs(void) const noexcept
+{
+	return { legs_, header_->count };
+}
+
+/* Prefix sums of leg lengths, see LegTable */
+std::span<const double> MissionBundle::cumulative(void) const noexcept
+{
+	return { cumulative_, header_->count + 1 };
+}
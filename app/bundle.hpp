@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "navframe.hpp"
+#include "route.hpp"
+
+/* Compiled mission: one file holding a solved mission and everything
+   navigation derives from it, so 'run --bundle' maps it and starts without
+   reading CSV, solving or building tables. The file holds a header, the
+   waypoints and the CSV row of each, the solved visiting order, the tour
+   projected into a local frame anchored at its start and the leg table.
+   Sections are 8-byte aligned in the host's byte order, and the header
+   carries a checksum of the whole file that open() verifies */
+class MissionBundle {
+    public:
+	MissionBundle(void) noexcept = default;
+	~MissionBundle(void);
+	MissionBundle(const MissionBundle &)		= delete;
+	MissionBundle &operator=(const MissionBundle &) = delete;
+
+	static bool write(const std::filesystem::path &,
+			  const std::filesystem::path &,
+			  const std::vector<std::pair<double, double> > &,
+			  const std::vector<std::size_t> &,
+			  const std::vector<std::size_t> &);
+	bool	    open(const std::filesystem::path &);
+	void	    close(void) noexcept;
+	bool	    isOpen(void) const noexcept;
+
+	std::vector<std::pair<double, double> > waypoints(void) const;
+	std::vector<std::size_t>		order(void) const;
+	std::vector<std::size_t>		csvRows(void) const;
+	std::filesystem::path			csvFile(void) const;
+	std::pair<double, double>		anchor(void) const noexcept;
+	double					length(void) const noexcept;
+	std::vector<LocalFrame::Point>		projected(void) const;
+	std::span<const LegTable::Leg>		legs(void) const noexcept;
+	std::span<const double>			cumulative(void) const noexcept;
+
+    private:
+	/* Fixed-size file header, followed by 'count' waypoints as latitude,
+	   longitude doubles as solved, 'count' 64-bit CSV rows, 'count'
+	   64-bit tour order indices, 'count' projected tour points as east,
+	   north doubles, 'count' legs and 'count' + 1 cumulative lengths */
+	struct Header {
+		std::uint32_t magic;	     /* "AWMB" */
+		std::uint32_t version;	     /* Layout version */
+		std::uint64_t count;	     /* Waypoints in tour */
+		std::uint64_t checksum;	     /* FNV-1a of file with this field
+						zeroed */
+		double	      anchorLat;     /* Frame anchor, the tour's start */
+		double	      anchorLon;     /* Frame anchor, the tour's start */
+		double	      length;	     /* Tour length in meters */
+		char	      csvFile[256];  /* Mission CSV path */
+	};
+
+	static constexpr std::uint32_t magicValue{ 0x424d5741 }; /* "AWMB" */
+	static constexpr std::uint32_t versionValue{ 1 };
+
+	static_assert(sizeof(LegTable::Leg) == 5 * sizeof(double),
+		      "Leg must be stored unpadded");
+
+	void		    *map_{ nullptr }; /* Mapped file */
+	std::size_t	     size_{ 0 };       /* Mapped bytes */
+	const Header	    *header_{ nullptr };
+	const double	    *waypoints_{ nullptr };
+	const std::uint64_t *csvRows_{ nullptr };
+	const std::uint64_t *order_{ nullptr };
+	const double	    *projected_{ nullptr };
+	const LegTable::Leg *legs_{ nullptr };
+	const double	    *cumulative_{ nullptr };
+
+	static std::size_t   fileSize(std::size_t) noexcept;
+	static std::uint64_t checksum(const unsigned char *,
+				      std::size_t) noexcept;
+	void		     bind(void *, std::size_t) noexcept;
+};
@@ -0,0 +1,184 @@
+#include "command.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+
+/* Helper to prefix shared-memory object name with '/' as POSIX requires */
+static std::string shmName(const std::string &name)
+{
+	return name.starts_with('/') ? name : "/" + name;
+}
+
+/* Destructor */
+CommandPublisher::~CommandPublisher(void)
+{
+	close();
+}
+
+/* Create, size and map shared-memory object 'name' */
+/* Returns false if the channel could not be created */
+bool CommandPublisher::open(const std::string &name)
+{
+	close();
+	std::string shm{ shmName(name) };
+	int	    fd{ shm_open(shm.c_str(), O_CREAT | O_RDWR, 0644) };
+	if (fd < 0) {
+		std::cerr << "Error: cannot create command channel '" << shm
+			  << "'.\n";
+		return false;
+	}
+	if (ftruncate(fd, sizeof(CommandSegment)) < 0) {
+		std::cerr << "Error: cannot size command channel '" << shm
+			  << "'.\n";
+		::close(fd);
+		shm_unlink(shm.c_str());
+		return false;
+	}
+	void *addr{ mmap(nullptr, sizeof(CommandSegment),
+			 PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+	::close(fd);
+	if (addr == MAP_FAILED) {
+		std::cerr << "Error: cannot map command channel '" << shm
+			  << "'.\n";
+		shm_unlink(shm.c_str());
+		return false;
+	}
+	/* Initialise segment, marking it ready last */
+	segment_ = new (addr) CommandSegment{};
+	segment_->version = CommandSegment::versionValue;
+	segment_->sequence.store(0, std::memory_order_relaxed);
+	segment_->generation.store(0, std::memory_order_relaxed);
+	segment_->magic.store(CommandSegment::magicValue,
+			      std::memory_order_release);
+	name_ = std::move(shm);
+	return true;
+}
+
+/* Unmap and unlink channel, if open */
+void CommandPublisher::close(void) noexcept
+{
+	if (segment_) {
+		segment_->magic.store(0, std::memory_order_release);
+		munmap(segment_, sizeof(CommandSegment));
+		shm_unlink(name_.c_str());
+		segment_ = nullptr;
+	}
+}
+
+/* Whether channel is open */
+bool CommandPublisher::isOpen(void) const noexcept
+{
+	return segment_;
+}
+
+/* Publish 'command', never blocking on readers */
+void CommandPublisher::publish(const NavCommand &command) noexcept
+{
+	std::uint64_t words[CommandSegment::words]{};
+	std::memcpy(words, &command, sizeof(NavCommand));
+	std::uint64_t seq{ segment_->sequence.load(std::memory_order_relaxed) };
+	/* Odd sequence marks write in progress */
+	segment_->sequence.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (std::size_t i = 0; i < CommandSegment::words; i++) {
+		segment_->payload[i].store(words[i], std::memory_order_relaxed);
+	}
+	segment_->generation.fetch_add(1, std::memory_order_relaxed);
+	segment_->sequence.store(seq + 2, std::memory_order_release);
+}
+
+/* Destructor */
+CommandReader::~CommandReader(void)
+{
+	close();
+}
+
+/* Map existing shared-memory object 'name' read-only */
+/* Returns false if no publisher has created the channel yet */
+bool CommandReader::open(const std::string &name)
+{
+	close();
+	std::string shm{ shmName(name) };
+	int	    fd{ shm_open(shm.c_str(), O_RDONLY, 0) };
+	if (fd < 0) {
+		return false;
+	}
+	void *addr{ mmap(nullptr, sizeof(CommandSegment), PROT_READ,
+			 MAP_SHARED, fd, 0) };
+	::close(fd);
+	if (addr == MAP_FAILED) {
+		return false;
+	}
+	segment_ = static_cast<const CommandSegment *>(addr);
+	if (segment_->magic.load(std::memory_order_acquire) !=
+		    CommandSegment::magicValue ||
+	    segment_->version != CommandSegment::versionValue) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+/* Unmap channel, if open */
+void CommandReader::close(void) noexcept
+{
+	if (segment_) {
+		munmap(const_cast<CommandSegment *>(segment_),
+		       sizeof(CommandSegment));
+		segment_ = nullptr;
+	}
+}
+
+/* Whether channel is open */
+bool CommandReader::isOpen(void) const noexcept
+{
+	return segment_;
+}
+
+/* Number of commands published so far */
+std::uint64_t CommandReader::generation(void) const noexcept
+{
+	return segment_->generation.load(std::memory_order_acquire);
+}
+
+/* Single wait-free attempt at reading latest command */
+/* Returns null if the publisher was mid-write */
+std::optional<NavCommand> CommandReader::tryRead(void) const noexcept
+{
+	std::uint64_t words[CommandSegment::words];
+	std::uint64_t before{ segment_->sequence.load(
+		std::memory_order_acquire) };
+	if (before & 1) {
+		return std::nullopt;
+	}
+	for (std::size_t i = 0; i < CommandSegment::words; i++) {
+		words[i] = segment_->payload[i].load(std::memory_order_relaxed);
+	}
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (segment_->sequence.load(std::memory_order_relaxed) != before) {
+		return std::nullopt;
+	}
+	NavCommand command;
+	std::memcpy(&command, words, sizeof(NavCommand));
+	return command;
+}
+
+/* Read latest command, retrying while the publisher writes */
+NavCommand CommandReader::read(void) const noexcept
+{
+	while (true) {
+		if (auto command{ tryRead() }) {
+			return *command;
+		}
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+/* Condition of the navigator issuing a NavCommand */
+enum class NavStatus : std::uint32_t {
+	ok	= 0, /* Steering normally, or tour completed */
+	gpsLost = 1  /* GPS signal lost, command is the last one steered */
+};
+
+/* Fixed-layout navigation command for the downstream motor controller */
+struct NavCommand {
+	double	      bearing;	      /* Degrees from true North */
+	double	      latitude;	      /* Current position */
+	double	      longitude;      /* Current position */
+	double	      destLatitude;   /* Next destination */
+	double	      destLongitude;  /* Next destination */
+	double	      distance;	      /* Meters to next destination */
+	double	      crossTrack;     /* Meters off current leg, positive
+					 right of track */
+	double	      percent;	      /* Percent of tour length completed */
+	std::uint64_t waypoint;	      /* CSV index of next destination */
+	std::int64_t  timestamp;      /* Nanoseconds since Unix epoch */
+	std::uint32_t completed;      /* Nonzero once tour has completed */
+	std::uint32_t status;	      /* NavStatus */
+};
+
+static_assert(std::is_trivially_copyable_v<NavCommand>);
+
+/* Layout of the shared-memory segment. The payload is copied word by word
+   through relaxed atomics under a seqlock: 'sequence' is odd while the
+   publisher writes, and readers retry if it changed across their copy.
+   'generation' counts published commands so readers can tell fresh from
+   stale */
+struct CommandSegment {
+	static constexpr std::uint32_t magicValue{ 0x534e5741 }; /* "AWNS" */
+	static constexpr std::uint32_t versionValue{ 1 };
+	static constexpr std::size_t   words{ (sizeof(NavCommand) + 7) / 8 };
+
+	std::atomic<std::uint32_t>	       magic;	   /* Set once ready */
+	std::uint32_t			       version;	   /* Layout version */
+	alignas(64) std::atomic<std::uint64_t> sequence;   /* Seqlock */
+	std::atomic<std::uint64_t>	       generation; /* Commands published */
+	std::atomic<std::uint64_t>	       payload[words]; /* NavCommand */
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+/* Single writer of a POSIX shared-memory command channel, which is created
+   on open() and unlinked on close() */
+class CommandPublisher {
+    public:
+	CommandPublisher(void) noexcept = default;
+	~CommandPublisher(void);
+	CommandPublisher(const CommandPublisher &)	      = delete;
+	CommandPublisher &operator=(const CommandPublisher &) = delete;
+
+	bool open(const std::string &);
+	void close(void) noexcept;
+	bool isOpen(void) const noexcept;
+	void publish(const NavCommand &) noexcept;
+
+    private:
+	CommandSegment *segment_{ nullptr }; /* Mapped segment */
+	std::string	name_;		     /* Shared-memory object name */
+};
+
+/* Any number of readers of a command channel, each polling without blocking
+   the publisher */
+class CommandReader {
+    public:
+	CommandReader(void) noexcept = default;
+	~CommandReader(void);
+	CommandReader(const CommandReader &)		= delete;
+	CommandReader &operator=(const CommandReader &) = delete;
+
+	bool			  open(const std::string &);
+	void			  close(void) noexcept;
+	bool			  isOpen(void) const noexcept;
+	std::uint64_t		  generation(void) const noexcept;
+	std::optional<NavCommand> tryRead(void) const noexcept;
+	NavCommand		  read(void) const noexcept;
+
+    private:
+	const CommandSegment *segment_{ nullptr }; /* Mapped segment */
+};
@@ -1,12 +1,27 @@
 #include "concorde.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <optional>
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "consolidate.hpp"
+#include "costs.hpp"
+#include "decompose.hpp"
+#include "heuristic.hpp"
+#include "process.hpp"
+
 /* Helper method to convert decimal degrees to TSPLIB "GEO" format */
 /* (deg*100 + min) */
 double ConcordeTSPSolver::decimalDegToTSPLIBGEO(double x) noexcept
@@ -24,47 +39,389 @@ double ConcordeTSPSolver::decimalDegToTSPLIBGEO(double x) noexcept
 }
 
 /* Writes out TSP file from waypoints to be used by Concorde executable*/
+/* The solver is handed the TSP text in memory, so the file in tspDir_ is
+   only a record and is skipped if no TSP directory is set */
 void ConcordeTSPSolver::writeTSPFile(void)
 {
 	/* Create TSP file path string */
 	std::string basename{ csvFile_.stem().string() };
 	tspFile_ = tspDir_ / (basename + ".tsp");
-	/* Write .tsp file in TSPLIB "GEO" format for Concorde */
-	std::ofstream tspOut(tspFile_);
-	tspOut << "NAME: " << basename << "\n";
-	tspOut << "TYPE: TSP\n";
-	tspOut << "COMMENT: generated from " << csvFile_.filename().string()
-	       << "\n";
-	tspOut << "DIMENSION: " << waypoints_.size() << "\n";
-	tspOut << "EDGE_WEIGHT_TYPE: GEO\n";
-	tspOut << "NODE_COORD_SECTION\n";
-	for (size_t i = 0; i < waypoints_.size(); ++i) {
-		double xx = decimalDegToTSPLIBGEO(waypoints_[i].first);
-		double yy = decimalDegToTSPLIBGEO(waypoints_[i].second);
-		tspOut << std::fixed << std::setprecision(4) << (i + 1) << " "
-		       << xx << " " << yy << "\n";
-	}
-	tspOut << "EOF\n";
-	tspOut.close();
-	std::cout << "Wrote TSP file: " << tspFile_ << ".\n";
+	if (!costs_.empty()) {
+		/* Asymmetric costs go to an external solver as a symmetric
+		   instance, and the builtin solver reads them directly */
+		tspText_ = solver_ == builtinSolver ?
+				   std::string{} :
+				   symmetricText(costMatrix());
+	} else {
+		/* Build TSP text in TSPLIB "GEO" format for Concorde */
+		std::ostringstream tspOut{};
+		tspOut << "NAME: " << basename << "\n";
+		tspOut << "TYPE: TSP\n";
+		tspOut << "COMMENT: generated from "
+		       << csvFile_.filename().string() << "\n";
+		tspOut << "DIMENSION: " << waypoints_.size() << "\n";
+		tspOut << "EDGE_WEIGHT_TYPE: GEO\n";
+		tspOut << "NODE_COORD_SECTION\n";
+		for (size_t i = 0; i < waypoints_.size(); ++i) {
+			double xx =
+				decimalDegToTSPLIBGEO(waypoints_[i].first);
+			double yy =
+				decimalDegToTSPLIBGEO(waypoints_[i].second);
+			tspOut << std::fixed << std::setprecision(4) << (i + 1)
+			       << " " << xx << " " << yy << "\n";
+		}
+		tspOut << "EOF\n";
+		tspText_ = tspOut.str();
+	}
+	if (tspDir_.empty() || tspText_.empty()) {
+		return;
+	}
+	std::ofstream tspFile(tspFile_);
+	tspFile << tspText_;
+	tspFile.close();
+	if (verbose_) {
+		std::cout << "Wrote TSP file: " << tspFile_ << ".\n";
+	}
 }
 
 /* Calls on Concorde to solve the TSP file and write out solution file */
+/* The solver runs without a shell, reading the TSP text from and writing
+   its solution to in-memory files, and is killed if it outlives timeout_.
+   The 'builtin' solver instead runs TourHeuristic in-process for at most
+   timeout_. With a cost matrix, the tour is solved against it instead, see
+   solveAsymmetric(). Otherwise with a turn penalty, any backend's tour is
+   then refined against it. The solution file in solDir_ is only a record,
+   for plotting, and is skipped if no solution directory is set */
 void ConcordeTSPSolver::solveTSP(void)
 {
 	/* Create solution file path string */
 	std::string basename{ tspFile_.stem().string() };
 	solFile_ = solDir_ / (basename + ".sol");
+	solText_.clear();
+	/* Drop the previous tour, so a failed solve leaves none */
+	tourOrder_.clear();
+	tour_.clear();
+	if (!costs_.empty()) {
+		if (!solveAsymmetric()) {
+			return;
+		}
+	} else if (clusters_ && waypoints_.size() > 3) {
+		solveDecomposed();
+	} else if (solver_ == builtinSolver) {
+		solveBuiltin();
+	} else if (!solveExternal()) {
+		return;
+	}
+	if (turnPenalty_ > 0.0 && costs_.empty()) {
+		refineTurns();
+	}
+	/* Consolidated tours are recorded in CSV indices once read */
+	if (solDir_.empty() || consolidated_) {
+		return;
+	}
+	std::ofstream solFile(solFile_);
+	solFile << solText_;
+	solFile.close();
+	if (verbose_) {
+		std::cout << "Concorde wrote solution: " << solFile_ << "\n";
+	}
+}
+
+/* Helper method to solve with the builtin heuristic */
+void ConcordeTSPSolver::solveBuiltin(void)
+{
+	TourHeuristic heuristic{};
+	heuristic.setTimeLimit(timeout_);
+	setSolution(heuristic.solve(waypoints_));
+}
+
+/* Helper method to solve by clusters, each cluster and the order of
+   clusters being solved by this solver's executable or heuristic */
+void ConcordeTSPSolver::solveDecomposed(void)
+{
+	ClusterDecomposer decomposer{
+		[solver = solver_, timeout = timeout_](const auto &part) {
+			ConcordeTSPSolver sub{};
+			sub.setVerbose(false);
+			sub.setSolver(solver);
+			sub.setTimeout(timeout);
+			sub.setWaypoints(part);
+			sub.writeTSPFile();
+			sub.solveTSP();
+			sub.readTSPSolution();
+			return sub.getTourOrder();
+		}
+	};
+	decomposer.setClusters(*clusters_);
+	decomposer.setTimeLimit(timeout_);
+	setSolution(decomposer.solve(waypoints_));
+	if (verbose_) {
+		std::cout << "Solved " << waypoints_.size() << " waypoints in "
+			  << decomposer.clusterCount() << " clusters.\n";
+	}
+}
+
+/* Helper method to load traversal costs for waypoints just read from CSV:
+   from '<stem>.costs' beside the CSV if present, else estimated from the
+   elevation grid if set, else none */
+/* A cost file is a header of "AWCM", layout version 1 and waypoint count,
+   in 32, 32 and 64 bits, followed by the row-major matrix of doubles, see
+   CostMatrix */
+void ConcordeTSPSolver::loadCosts(void)
+{
+	costs_ = CostMatrix{};
+	auto costFile{ csvFile_ };
+	costFile.replace_extension(".costs");
+	if (std::filesystem::exists(costFile)) {
+		if (!costs_.open(costFile) ||
+		    costs_.size() != waypoints_.size()) {
+			std::cerr << "Error: " << costFile
+				  << " is not a cost matrix for "
+				  << waypoints_.size()
+				  << " waypoints, ignoring.\n";
+			costs_ = CostMatrix{};
+		} else if (verbose_) {
+			std::cout << "Loaded traversal costs: " << costFile
+				  << ".\n";
+		}
+	} else if (elevation_) {
+		costs_.estimate(*elevation_, waypoints_);
+		if (verbose_) {
+			std::cout << "Estimated traversal costs from elevation "
+				     "grid.\n";
+		}
+	}
+}
+
+/* Helper method to gather costs between waypoints_ from costs_, an 'n' by
+   'n' row-major matrix for 'n' waypoints */
+std::vector<double> ConcordeTSPSolver::costMatrix(void) const
+{
+	std::size_t	    n{ waypoints_.size() };
+	std::vector<double> costs(n * n);
+	for (std::size_t i = 0; i < n; i++) {
+		for (std::size_t j = 0; j < n; j++) {
+			costs[i * n + j] = costs_(csvIndex(i), csvIndex(j));
+		}
+	}
+	return costs;
+}
+
+/* Helper method to build TSPLIB text of the symmetric instance equivalent
+   to asymmetric 'costs', see costMatrix() */
+/* Standard transformation to 2n nodes: waypoint i becomes entry node i and
+   exit node n + i, joined at no cost. Exit node n + i joins entry node j at
+   the cost of travelling from i to j plus a fixed offset, and nodes of the
+   same kind are never joined, so an optimal tour alternates entry and exit
+   nodes. Costs are scaled to integers of up to costScale */
+std::string
+ConcordeTSPSolver::symmetricText(const std::vector<double> &costs) const
+{
+	constexpr double	costScale{ 10000.0 };
+	constexpr std::uint32_t offset{ 1000000 };   /* Added to each leg */
+	constexpr std::uint32_t never{ 100000000 };  /* Cost of same-kind
+							edge */
+	std::size_t n{ waypoints_.size() };
+	double	    most{ 0.0 };
+	for (double c : costs) {
+		most = std::max(most, c);
+	}
+	double		      scale{ most > 0.0 ? costScale / most : 0.0 };
+	auto		      leg{ [&](std::size_t from, std::size_t to) {
+		       return offset + static_cast<std::uint32_t>(std::lround(
+					       std::max(costs[from * n + to], 0.0) *
+					       scale));
+	} };
+	std::string text{};
+	text += "NAME: " + csvFile_.stem().string() + "\n";
+	text += "TYPE: TSP\n";
+	text += "COMMENT: asymmetric costs for " +
+		csvFile_.filename().string() + "\n";
+	text += "DIMENSION: " + std::to_string(2 * n) + "\n";
+	text += "EDGE_WEIGHT_TYPE: EXPLICIT\n";
+	text += "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n";
+	text += "EDGE_WEIGHT_SECTION\n";
+	char buf[16];
+	for (std::size_t r = 0; r < 2 * n; r++) {
+		for (std::size_t c = 0; c < 2 * n; c++) {
+			/* Entry or exit nodes, and their waypoints */
+			bool	    rExit{ r >= n }, cExit{ c >= n };
+			std::size_t i{ r % n }, j{ c % n };
+			std::uint32_t w{};
+			if (rExit == cExit) {
+				w = r == c ? 0 : never;
+			} else if (i == j) {
+				w = 0;
+			} else {
+				w = rExit ? leg(i, j) : leg(j, i);
+			}
+			auto end{ std::to_chars(buf, buf + sizeof(buf), w).ptr };
+			*end++ = c + 1 < 2 * n ? ' ' : '\n';
+			text.append(buf, end);
+		}
+	}
+	text += "EOF\n";
+	return text;
+}
+
+/* Helper method to read visiting order from the solver's tour of the
+   instance built by symmetricText(), in solText_ */
+/* Returns an empty order unless the tour alternates entry and exit nodes,
+   each entry next to its own exit */
+std::vector<std::size_t> ConcordeTSPSolver::asymmetricOrder(void) const
+{
+	std::size_t		 n{ waypoints_.size() };
+	std::istringstream	 solIn{ solText_ };
+	std::size_t		 dim{}, cnt{};
+	std::vector<std::size_t> nodes{};
+	if (!(solIn >> dim >> cnt) || dim != 2 * n) {
+		return {};
+	}
+	for (std::size_t i = 0; i < dim; i++) {
+		std::size_t from{}, to{}, weight{};
+		if (!(solIn >> from >> to >> weight) || from >= dim) {
+			return {};
+		}
+		nodes.push_back(from);
+	}
+	/* Start at the starting position's entry, leaving by its exit */
+	std::ranges::rotate(nodes, std::ranges::find(nodes, 0));
+	if (nodes[1] != n) {
+		std::reverse(nodes.begin() + 1, nodes.end());
+	}
+	std::vector<std::size_t> order{};
+	std::vector<bool>	 seen(n, false);
+	for (std::size_t i = 0; i < dim; i += 2) {
+		std::size_t v{ nodes[i] };
+		if (v >= n || nodes[i + 1] != n + v || seen[v]) {
+			return {};
+		}
+		seen[v] = true;
+		order.push_back(v);
+	}
+	return order;
+}
+
+/* Helper method to solve against cost matrix instead of distance */
+/* An external solver is run on the symmetric transformation of the costs,
+   see symmetricText(), and its tour improved by the builtin heuristic
+   against them. The builtin solver, or an external tour that does not map
+   back, falls back to TourHeuristic::solveAsymmetric(). Returns false if the
+   external solver failed */
+bool ConcordeTSPSolver::solveAsymmetric(void)
+{
+	std::size_t		 n{ waypoints_.size() };
+	auto			 costs{ costMatrix() };
+	TourHeuristic		 heuristic{};
+	std::vector<std::size_t> order{};
+	heuristic.setTimeLimit(timeout_);
+	if (solver_ != builtinSolver) {
+		if (!solveExternal()) {
+			return false;
+		}
+		order = asymmetricOrder();
+		if (order.empty()) {
+			std::cerr << "Asymmetric tour malformed on: " << tspFile_
+				  << ", solving with builtin.\n";
+		} else {
+			order = heuristic.improveAsymmetric(costs, n, order);
+		}
+	}
+	if (order.empty()) {
+		order = heuristic.solveAsymmetric(costs, n);
+	}
+	setSolution(order);
+	if (verbose_) {
+		auto reversed{ order };
+		std::reverse(reversed.begin() + 1, reversed.end());
+		std::cout << std::fixed << std::setprecision(1)
+			  << "Traversal cost " << TourHeuristic::tourCost(costs, n, order)
+			  << ", " << TourHeuristic::tourCost(costs, n, reversed)
+			  << " in reverse.\n"
+			  << std::defaultfloat << std::setprecision(6);
+	}
+	return true;
+}
+
+/* Helper method to write 'order' to solText_ in linkern's edge list
+   format */
+void ConcordeTSPSolver::setSolution(const std::vector<std::size_t> &order)
+{
+	std::ostringstream solOut{};
+	solOut << order.size() << " " << order.size() << "\n";
+	for (std::size_t i = 0; i < order.size(); i++) {
+		solOut << order[i] << " " << order[(i + 1) % order.size()]
+		       << " 0\n";
+	}
+	solText_ = solOut.str();
+}
+
+/* Helper method to refine tour in solText_ against distance plus turn
+   penalty with TourHeuristic, printing both before and after */
+/* solText_ is left alone if it is not a whole tour */
+void ConcordeTSPSolver::refineTurns(void)
+{
+	std::istringstream	 solIn{ solText_ };
+	std::size_t		 dim{}, cnt{};
+	std::vector<std::size_t> order{};
+	std::vector<bool>	 seen(waypoints_.size(), false);
+	if (!(solIn >> dim >> cnt) || dim != waypoints_.size()) {
+		return;
+	}
+	for (std::size_t i = 0; i < dim; i++) {
+		std::size_t from{}, to{}, weight{};
+		if (!(solIn >> from >> to >> weight) || from >= dim ||
+		    seen[from]) {
+			return;
+		}
+		seen[from] = true;
+		order.push_back(from);
+	}
+	TourHeuristic heuristic{};
+	heuristic.setTimeLimit(timeout_);
+	heuristic.setTurnPenalty(turnPenalty_);
+	auto refined{ heuristic.improve(waypoints_, order) };
+	setSolution(refined);
+	if (verbose_) {
+		std::cout << std::fixed << std::setprecision(1)
+			  << "Turn penalty " << turnPenalty_ << " m: length "
+			  << TourHeuristic::tourLength(waypoints_, order)
+			  << " m -> "
+			  << TourHeuristic::tourLength(waypoints_, refined)
+			  << " m, turn cost "
+			  << TourHeuristic::turnCost(waypoints_, order,
+						     turnPenalty_)
+			  << " m -> "
+			  << TourHeuristic::turnCost(waypoints_, refined,
+						     turnPenalty_)
+			  << " m.\n"
+			  << std::defaultfloat << std::setprecision(6);
+	}
+}
+
+/* Helper method to run the external solver on tspText_ into solText_ */
+/* Returns false if it failed or timed out */
+bool ConcordeTSPSolver::solveExternal(void)
+{
 	/* Run Concorde executable to get optimal solution */
-	std::ostringstream cmd;
-	cmd << "linkern -o " << solFile_ << " " << tspFile_
-	    << " > /dev/null 2>&1";
-	int ret = std::system(cmd.str().c_str());
-	if (ret != 0) {
+	MemFile tspIn{ "tsp" };
+	MemFile solOut{ "sol" };
+	if (!tspIn.isOpen() || !solOut.isOpen() || !tspIn.write(tspText_)) {
 		std::cerr << "Concorde failed on: " << tspFile_ << "\n";
-	} else {
-		std::cout << "Concorde wrote solution: " << solFile_ << "\n";
+		return false;
+	}
+	auto result{ ProcessRunner::shared().run(
+		{ solver_, "-o", MemFile::childPath(1), MemFile::childPath(0) },
+		timeout_, { tspIn.fd(), solOut.fd() }) };
+	if (result.timedOut) {
+		std::cerr << "Concorde timed out on: " << tspFile_ << "\n";
+		return false;
+	} else if (!result.ok()) {
+		std::cerr << "Concorde failed on: " << tspFile_ << "\n";
+		return false;
 	}
+	solText_ = solOut.read();
+	return true;
 }
 
 /* Reads TSP solution in route order vector */
@@ -73,12 +430,12 @@ void ConcordeTSPSolver::readTSPSolution(void)
 	/* Create path to graph file */
 	std::string basename{ solFile_.stem() };
 	graphFile_ = graphDir_ / (basename + ".png");
-	/* Try to open solution file */
-	std::ifstream solIn(solFile_);
-	if (!solIn) {
+	/* Check that solver produced a solution */
+	if (solText_.empty()) {
 		std::cerr << "Cannot open solution: " << solFile_ << "\n";
 		return;
 	}
+	std::istringstream solIn{ solText_ };
 	std::size_t dim, cnt;
 	/* Check that Concorde has generated valid solution file */
 	if (!(solIn >> dim >> cnt)) {
@@ -93,30 +450,58 @@ void ConcordeTSPSolver::readTSPSolution(void)
 		if (!(solIn >> tourOrder_[i] >> dummy >> dummy)) {
 			std::cerr << "Malformed .sol (too few indices): "
 				  << solFile_ << "\n";
-			break;
+			tourOrder_.clear();
+			return;
 		}
 	}
-	solIn.close();
 	/* Print out tour order */
-	std::cout << "Solution for " << solFile_ << ": ";
-	for (int idx : tourOrder_) {
-		std::cout << idx << " ";
+	if (verbose_) {
+		std::cout << "Solution for " << solFile_ << ": ";
+		for (std::size_t idx : tourOrder_) {
+			std::cout << csvIndex(idx) << " ";
+		}
+		std::cout << "\n";
 	}
-	std::cout << "\n";
 	/* Reorder initial waypoints_ into tour_ */
 	tour_.resize(dim);
 	for (std::size_t i = 0; i < dim; i++) {
 		tour_[i] = waypoints_[tourOrder_[i]];
 	}
+	if (consolidated_ && !solDir_.empty()) {
+		writeCSVSolution();
+	}
+}
+
+/* Helper method to record consolidated tour over every CSV waypoint, each
+   merged waypoint following its group's anchor, for plotting against the
+   CSV */
+void ConcordeTSPSolver::writeCSVSolution(void)
+{
+	auto	      order{ consolidator_.expand(tourOrder_) };
+	std::ofstream solFile(solFile_);
+	solFile << order.size() << " " << order.size() << "\n";
+	for (std::size_t i = 0; i < order.size(); i++) {
+		solFile << order[i] << " " << order[(i + 1) % order.size()]
+			<< " 0\n";
+	}
+	solFile.close();
+	if (verbose_) {
+		std::cout << "Concorde wrote solution: " << solFile_ << "\n";
+	}
 }
 
 /* Calls Python script to plot solved route for visulization */
+/* Skipped if there is no solution file or graph directory */
 void ConcordeTSPSolver::plotTSPSolution(void)
 {
-	std::ostringstream cmd{};
-	cmd << "visualize " << csvFile_ << " " << solFile_ << " " << graphFile_;
-	int ret = std::system(cmd.str().c_str());
-	if (ret != 0) {
+	if (solDir_.empty() || graphDir_.empty() || solText_.empty()) {
+		return;
+	}
+	auto result{ ProcessRunner::shared().run(
+		{ "visualize", csvFile_.string(), solFile_.string(),
+		  graphFile_.string() },
+		timeout_) };
+	if (!result.ok()) {
 		std::cerr << "Graphing failed on: " << graphFile_ << "\n";
 	}
 }
@@ -127,6 +512,82 @@ const std::filesystem::path &ConcordeTSPSolver::getCSVDir(void) noexcept
 	return csvDir_;
 }
 
+/* Getter for solution directory */
+const std::filesystem::path &ConcordeTSPSolver::getSolDir(void) noexcept
+{
+	return solDir_;
+}
+
+/* Setter for whether progress is printed, errors are always printed */
+void ConcordeTSPSolver::setVerbose(bool verbose) noexcept
+{
+	verbose_ = verbose;
+}
+
+/* Setter for solver executable, which must take linkern's arguments, or
+   'builtin' for the in-process heuristic */
+void ConcordeTSPSolver::setSolver(std::string solver)
+{
+	solver_ = std::move(solver);
+}
+
+/* Setter for radius in meters within which waypoints read from CSV are
+   merged before solving, 0 for none */
+/* See WaypointConsolidator. Indices into getWaypoints() then name group
+   anchors, which csvIndex() maps back to CSV rows */
+void ConcordeTSPSolver::setConsolidationRadius(double radius) noexcept
+{
+	consolidator_.setRadius(radius);
+}
+
+/* CSV row of waypoint 'i' of getWaypoints(), counting the starting position
+   as 0 */
+std::size_t ConcordeTSPSolver::csvIndex(std::size_t i) const noexcept
+{
+	return csvRows_.empty() ? i : csvRows_[i];
+}
+
+/* CSV row of each waypoint of getWaypoints(), see csvIndex() */
+std::vector<std::size_t> ConcordeTSPSolver::csvRows(void) const
+{
+	std::vector<std::size_t> rows(waypoints_.size());
+	for (std::size_t i = 0; i < rows.size(); i++) {
+		rows[i] = csvIndex(i);
+	}
+	return rows;
+}
+
+/* Setter for cluster-decomposed solving, see ClusterDecomposer */
+/* 'clusters' is the number of clusters, 0 to choose from mission size, or
+   empty to solve flat */
+void ConcordeTSPSolver::setClusters(std::optional<std::size_t> clusters) noexcept
+{
+	clusters_ = clusters;
+}
+
+/* Setter for turn penalty in meters, see TourHeuristic::setTurnPenalty() */
+/* If set, tours minimise distance plus the penalty of each heading change,
+   approximating drive time for vehicles that slow down to turn. 0 minimises
+   distance only */
+void ConcordeTSPSolver::setTurnPenalty(double penalty) noexcept
+{
+	turnPenalty_ = std::max(penalty, 0.0);
+}
+
+/* Setter for elevation grid to estimate traversal costs from, for missions
+   without a cost matrix file, see loadCosts() */
+void ConcordeTSPSolver::setElevationGrid(
+	std::shared_ptr<const ElevationGrid> elevation) noexcept
+{
+	elevation_ = std::move(elevation);
+}
+
+/* Setter for deadline of each solver or plotter run, 0 for none */
+void ConcordeTSPSolver::setTimeout(std::chrono::milliseconds timeout) noexcept
+{
+	timeout_ = timeout;
+}
+
 /* Getter for tour_ */
 const std::vector<std::pair<double, double> > &
 ConcordeTSPSolver::getTour(void) noexcept
@@ -140,11 +601,65 @@ const std::vector<std::size_t> &ConcordeTSPSolver::getTourOrder(void) noexcept
 	return tourOrder_;
 }
 
+/* Getter for waypoints_ */
+const std::vector<std::pair<double, double> > &
+ConcordeTSPSolver::getWaypoints(void) noexcept
+{
+	return waypoints_;
+}
+
+/* Load waypoints and an already solved tour order directly */
+/* 'csvRows' optionally gives the CSV row of each waypoint, see csvIndex().
+   Returns false if the order is not a permutation of the waypoints */
+bool ConcordeTSPSolver::setTour(
+	const std::vector<std::pair<double, double> > &waypoints,
+	const std::vector<std::size_t>		      &order,
+	const std::vector<std::size_t>		      &csvRows)
+{
+	std::vector<bool> seen(waypoints.size(), false);
+	if (order.size() != waypoints.size() || waypoints.size() < 2 ||
+	    (!csvRows.empty() && csvRows.size() != waypoints.size())) {
+		return false;
+	}
+	for (std::size_t idx : order) {
+		if (idx >= waypoints.size() || seen[idx]) {
+			return false;
+		}
+		seen[idx] = true;
+	}
+	waypoints_    = waypoints;
+	tourOrder_    = order;
+	consolidated_ = false;
+	csvRows_      = csvRows;
+	costs_	      = CostMatrix{};
+	tour_.resize(order.size());
+	for (std::size_t i = 0; i < order.size(); i++) {
+		tour_[i] = waypoints_[tourOrder_[i]];
+	}
+	return true;
+}
+
+/* Load waypoints to solve directly instead of from CSV */
+void ConcordeTSPSolver::setWaypoints(
+	const std::vector<std::pair<double, double> > &waypoints)
+{
+	waypoints_    = waypoints;
+	consolidated_ = false;
+	csvRows_.clear();
+	costs_ = CostMatrix{};
+	tourOrder_.clear();
+	tour_.clear();
+}
+
 /* Read CSV file to load in waypoints */
 bool ConcordeTSPSolver::readCSV(void)
 {
-	/* First, clear waypoints_ */
+	/* First, clear waypoints_ and the tour solved for them */
 	waypoints_.clear();
+	consolidated_ = false;
+	csvRows_.clear();
+	tourOrder_.clear();
+	tour_.clear();
 	std::ifstream file;
 	/* Catch invalid file path */
 	file.open(csvFile_);
@@ -197,7 +712,29 @@ bool ConcordeTSPSolver::readCSV(void)
 		return false;
 	}
 	/* Else print number of waypoints and return true */
-	std::cout << numWaypoints << "/" << lineNo << " waypoints loaded for "
-		  << csvFile_ << ".\n";
+	if (verbose_) {
+		std::cout << numWaypoints << "/" << lineNo
+			  << " waypoints loaded for " << csvFile_ << ".\n";
+	}
+	loadCosts();
+	/* Merge near-duplicate waypoints, if enabled, keeping two or more */
+	if (consolidator_.radius() > 0.0 &&
+	    consolidator_.consolidate(waypoints_) >= 2 &&
+	    consolidator_.anchors().size() < waypoints_.size()) {
+		std::vector<std::pair<double, double> > anchors{};
+		anchors.reserve(consolidator_.anchors().size());
+		for (std::size_t i : consolidator_.anchors()) {
+			anchors.push_back(waypoints_[i]);
+		}
+		if (verbose_) {
+			std::cout << "Consolidated " << waypoints_.size()
+				  << " waypoints into " << anchors.size()
+				  << " within " << consolidator_.radius()
+				  << " m.\n";
+		}
+		waypoints_    = std::move(anchors);
+		consolidated_ = true;
+		csvRows_      = consolidator_.anchors();
+	}
 	return true;
 }
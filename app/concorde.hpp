@@ -1,11 +1,21 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "consolidate.hpp"
+#include "costs.hpp"
+
 class ConcordeTSPSolver {
     public:
+	/* Solver name selecting the in-process heuristic, see heuristic.hpp */
+	static constexpr const char *builtinSolver{ "builtin" };
+
 	/* Allow setting via any string-like or path-like type */
 	void setCSVFile(auto &&csvFile)
 	{
@@ -33,8 +43,25 @@ class ConcordeTSPSolver {
 	}
 
 	const std::filesystem::path		      &getCSVDir(void) noexcept;
+	const std::filesystem::path		      &getSolDir(void) noexcept;
 	const std::vector<std::pair<double, double> > &getTour(void) noexcept;
 	const std::vector<std::size_t> &getTourOrder(void) noexcept;
+	const std::vector<std::pair<double, double> > &getWaypoints(void) noexcept;
+
+	bool setTour(const std::vector<std::pair<double, double> > &,
+		     const std::vector<std::size_t> &,
+		     const std::vector<std::size_t> & = {});
+	void setWaypoints(const std::vector<std::pair<double, double> > &);
+
+	void setVerbose(bool) noexcept;
+	void setConsolidationRadius(double) noexcept;
+	void setClusters(std::optional<std::size_t>) noexcept;
+	void setTurnPenalty(double) noexcept;
+	void setElevationGrid(std::shared_ptr<const ElevationGrid>) noexcept;
+	std::size_t csvIndex(std::size_t) const noexcept;
+	std::vector<std::size_t> csvRows(void) const;
+	void setSolver(std::string);
+	void setTimeout(std::chrono::milliseconds) noexcept;
 
 	bool readCSV(void);
 	void writeTSPFile(void);
@@ -63,6 +90,39 @@ class ConcordeTSPSolver {
 					visited */
 	std::vector<std::pair<double, double> > tour_; /* Lat, lon pairs of
 							       tour */
+	bool verbose_{ true }; /* Flag to mark whether progress is printed */
+	std::string solver_{ "linkern" }; /* Solver executable */
+	std::chrono::milliseconds timeout_{ 300000 }; /* Deadline for each solver
+							 or plotter run, 0 for
+							 none */
+	WaypointConsolidator consolidator_; /* Merges waypoints read from CSV */
+	std::optional<std::size_t> clusters_; /* Clusters to solve in, 0 for
+						 automatic, empty to solve
+						 flat */
+	double turnPenalty_{ 0.0 }; /* Meters charged for reversing heading at
+				       a waypoint, 0 to minimise distance */
+	bool consolidated_{ false }; /* Flag to mark waypoints_ holds group
+					anchors rather than every CSV
+					waypoint */
+	std::vector<std::size_t> csvRows_; /* CSV row of each waypoint, empty if
+					      waypoints_ are the CSV rows */
+	std::shared_ptr<const ElevationGrid> elevation_; /* Terrain to estimate
+							    costs from */
+	CostMatrix costs_; /* Traversal costs by CSV row, empty to solve
+			      great-circle distances */
+	std::string tspText_; /* TSPLIB text of last TSP file */
+	std::string solText_; /* Solver output of last solve */
 
 	double decimalDegToTSPLIBGEO(double) noexcept;
+	void   solveBuiltin(void);
+	void   solveDecomposed(void);
+	bool   solveAsymmetric(void);
+	void   loadCosts(void);
+	std::vector<double>	 costMatrix(void) const;
+	std::string		 symmetricText(const std::vector<double> &) const;
+	std::vector<std::size_t> asymmetricOrder(void) const;
+	void   setSolution(const std::vector<std::size_t> &);
+	void   refineTurns(void);
+	bool   solveExternal(void);
+	void   writeCSVSolution(void);
 };
@@ -0,0 +1,177 @@
+#include "consolidate.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "navframe.hpp"
+
+/* Constructor */
+WaypointConsolidator::WaypointConsolidator(double radius) noexcept
+	: radius_{ std::max(radius, 0.0) }
+{
+}
+
+/* Setter for merge radius in meters, 0 to merge nothing */
+void WaypointConsolidator::setRadius(double radius) noexcept
+{
+	radius_ = std::max(radius, 0.0);
+}
+
+/* Getter for radius_ */
+double WaypointConsolidator::radius(void) const noexcept
+{
+	return radius_;
+}
+
+/* Group 'waypoints' within radius_ of their group's anchor */
+/* Returns number of groups, see anchors() and groups() */
+std::size_t WaypointConsolidator::consolidate(
+	const std::vector<std::pair<double, double> > &waypoints)
+{
+	std::size_t n{ waypoints.size() };
+	anchors_.clear();
+	groups_.assign(n, 0);
+	if (!n) {
+		return 0;
+	}
+	/* Project into frame about starting position */
+	LocalFrame		       frame{};
+	std::vector<LocalFrame::Point> points{};
+	frame.anchor(waypoints[0]);
+	points.reserve(n);
+	for (const auto &p : waypoints) {
+		points.push_back(frame.toLocal(p));
+	}
+	/* Union-find forest, each root being its group's anchor and the lowest
+	   index in it. 'spread' bounds the group's distance from its anchor */
+	std::vector<std::size_t> parent(n);
+	std::vector<double>	 spread(n, 0.0);
+	for (std::size_t i = 0; i < n; i++) {
+		parent[i] = i;
+	}
+	auto find{ [&](std::size_t i) {
+		std::size_t root{ i };
+		while (parent[root] != root) {
+			root = parent[root];
+		}
+		while (parent[i] != root) { /* Path compression */
+			i = std::exchange(parent[i], root);
+		}
+		return root;
+	} };
+	if (radius_ > 0.0) {
+		/* Hash waypoints by cell, near pairs then lie in adjacent
+		   cells */
+		auto cellOf{ [&](const LocalFrame::Point &p) {
+			return std::pair{ static_cast<std::int64_t>(
+						  std::floor(p.first / radius_)),
+					  static_cast<std::int64_t>(
+						  std::floor(p.second / radius_)) };
+		} };
+		auto key{ [](std::int64_t cx, std::int64_t cy) {
+			return static_cast<std::uint64_t>(cx) * 0x9e3779b97f4a7c15ULL ^
+			       static_cast<std::uint64_t>(cy);
+		} };
+		std::unordered_map<std::uint64_t, std::vector<std::size_t> >
+			grid{};
+		grid.reserve(n);
+		for (std::size_t i = 0; i < n; i++) {
+			auto [cx, cy]{ cellOf(points[i]) };
+			grid[key(cx, cy)].push_back(i);
+		}
+		double r2{ radius_ * radius_ };
+		for (std::size_t i = 0; i < n; i++) {
+			auto [cx, cy]{ cellOf(points[i]) };
+			for (std::int64_t dy = -1; dy <= 1; dy++) {
+				for (std::int64_t dx = -1; dx <= 1; dx++) {
+					auto cell{ grid.find(key(cx + dx, cy + dy)) };
+					if (cell == grid.end()) {
+						continue;
+					}
+					for (std::size_t j : cell->second) {
+						if (j <= i ||
+						    LocalFrame::distanceSq(
+							    points[i],
+							    points[j]) > r2) {
+							continue;
+						}
+						/* Merge higher anchor's group
+						   into lower's if it fits */
+						auto a{ find(i) };
+						auto b{ find(j) };
+						if (a == b) {
+							continue;
+						}
+						auto [keep, drop]{ std::minmax(
+							a, b) };
+						double d{ std::sqrt(
+							LocalFrame::distanceSq(
+								points[keep],
+								points[drop])) };
+						if (d + spread[drop] <= radius_) {
+							parent[drop] = keep;
+							spread[keep] = std::max(
+								spread[keep],
+								d + spread[drop]);
+						}
+					}
+				}
+			}
+		}
+	}
+	/* Number groups by anchor, in input order */
+	std::vector<std::size_t> group(n, n);
+	for (std::size_t i = 0; i < n; i++) {
+		auto root{ find(i) };
+		if (group[root] == n) {
+			group[root] = anchors_.size();
+			anchors_.push_back(root);
+		}
+		groups_[i] = group[root];
+	}
+	return anchors_.size();
+}
+
+/* Getter for anchors_ */
+const std::vector<std::size_t> &WaypointConsolidator::anchors(void) const noexcept
+{
+	return anchors_;
+}
+
+/* Getter for groups_ */
+const std::vector<std::size_t> &WaypointConsolidator::groups(void) const noexcept
+{
+	return groups_;
+}
+
+/* Map visiting 'order' over groups back to every input waypoint, each
+   group's members following its anchor in input order */
+std::vector<std::size_t>
+WaypointConsolidator::expand(const std::vector<std::size_t> &order) const
+{
+	/* Members of each group, by counting sort */
+	std::vector<std::size_t> start(anchors_.size() + 1, 0);
+	for (std::size_t g : groups_) {
+		start[g + 1]++;
+	}
+	for (std::size_t g = 0; g < anchors_.size(); g++) {
+		start[g + 1] += start[g];
+	}
+	std::vector<std::size_t> members(groups_.size());
+	std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+	for (std::size_t i = 0; i < groups_.size(); i++) {
+		members[fill[groups_[i]]++] = i;
+	}
+	std::vector<std::size_t> expanded{};
+	expanded.reserve(groups_.size());
+	for (std::size_t g : order) {
+		expanded.insert(expanded.end(), members.begin() + start[g],
+				members.begin() + start[g + 1]);
+	}
+	return expanded;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/* Pre-solve merging of waypoints closer together than a radius, so the
+   solver orders, and the navigator steers to, one waypoint per spot instead
+   of several within a tick of each other */
+/* Near pairs are found through a hashed grid of radius-sized cells and
+   merged with union-find. Each group is represented by its lowest-indexed
+   waypoint, its anchor, and a merge is only made if every member stays
+   within the radius of the anchor, so dense runs of points do not chain
+   into one long group. The starting position is always an anchor */
+class WaypointConsolidator {
+    public:
+	explicit WaypointConsolidator(double radius = 0.0) noexcept;
+
+	void	    setRadius(double) noexcept;
+	double	    radius(void) const noexcept;
+	std::size_t consolidate(const std::vector<std::pair<double, double> > &);
+	const std::vector<std::size_t> &anchors(void) const noexcept;
+	const std::vector<std::size_t> &groups(void) const noexcept;
+	std::vector<std::size_t> expand(const std::vector<std::size_t> &) const;
+
+    private:
+	double			 radius_;  /* Merge radius in meters */
+	std::vector<std::size_t> anchors_; /* Input index of each group's
+					      anchor, ascending */
+	std::vector<std::size_t> groups_;  /* Group of each input waypoint */
+};
@@ -0,0 +1,196 @@
+#include "costs.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "route.hpp"
+
+/* Read grid from ESRI ASCII file 'path' */
+/* Returns false if it is missing or malformed */
+bool ElevationGrid::load(const std::filesystem::path &path)
+{
+	std::ifstream file{ path };
+	if (!file) {
+		return false;
+	}
+	/* Header of keyword, value lines, case-insensitive */
+	double	    xll{ 0.0 }, yll{ 0.0 };
+	bool	    centred{ false };
+	std::size_t fields{ 0 };
+	std::string key{};
+	while (file >> key) {
+		std::ranges::transform(key, key.begin(), [](unsigned char c) {
+			return static_cast<char>(std::tolower(c));
+		});
+		if (key == "ncols") {
+			file >> ncols_;
+		} else if (key == "nrows") {
+			file >> nrows_;
+		} else if (key == "xllcorner" || key == "xllcenter") {
+			file >> xll;
+			centred = key == "xllcenter";
+		} else if (key == "yllcorner" || key == "yllcenter") {
+			file >> yll;
+		} else if (key == "cellsize") {
+			file >> cell_;
+		} else if (key == "nodata_value") {
+			file >> nodata_;
+		} else {
+			/* First elevation */
+			try {
+				z_.assign(1, std::stod(key));
+			} catch (const std::exception &) {
+				return false;
+			}
+			break;
+		}
+		fields++;
+	}
+	if (fields < 5 || !ncols_ || !nrows_ || cell_ <= 0.0) {
+		return false;
+	}
+	x0_ = centred ? xll : xll + cell_ / 2.0;
+	y0_ = centred ? yll : yll + cell_ / 2.0;
+	z_.reserve(ncols_ * nrows_);
+	for (double z{}; z_.size() < ncols_ * nrows_ && file >> z;) {
+		z_.push_back(z);
+	}
+	return z_.size() == ncols_ * nrows_;
+}
+
+/* Elevation in meters at '{latitude, longitude}', interpolated bilinearly
+   between cell centres */
+/* Empty outside the grid or next to a missing cell */
+std::optional<double>
+ElevationGrid::at(const std::pair<double, double> &p) const noexcept
+{
+	if (z_.empty()) {
+		return std::nullopt;
+	}
+	/* Column from west and row from south, in cells */
+	double fx{ (p.second - x0_) / cell_ };
+	double fy{ (p.first - y0_) / cell_ };
+	if (fx < -0.5 || fy < -0.5 || fx > ncols_ - 0.5 || fy > nrows_ - 0.5) {
+		return std::nullopt;
+	}
+	fx = std::clamp(fx, 0.0, static_cast<double>(ncols_ - 1));
+	fy = std::clamp(fy, 0.0, static_cast<double>(nrows_ - 1));
+	auto	    c{ std::min(static_cast<std::size_t>(fx), ncols_ - 1) };
+	auto	    r{ std::min(static_cast<std::size_t>(fy), nrows_ - 1) };
+	std::size_t c1{ std::min(c + 1, ncols_ - 1) };
+	std::size_t r1{ std::min(r + 1, nrows_ - 1) };
+	auto	    z{ [&](std::size_t col, std::size_t row) {
+		   return z_[(nrows_ - 1 - row) * ncols_ + col];
+	} };
+	double	    z00{ z(c, r) }, z10{ z(c1, r) }, z01{ z(c, r1) },
+		z11{ z(c1, r1) };
+	if (z00 == nodata_ || z10 == nodata_ || z01 == nodata_ ||
+	    z11 == nodata_) {
+		return std::nullopt;
+	}
+	double tx{ fx - static_cast<double>(c) };
+	double ty{ fy - static_cast<double>(r) };
+	return (z00 * (1.0 - tx) + z10 * tx) * (1.0 - ty) +
+	       (z01 * (1.0 - tx) + z11 * tx) * ty;
+}
+
+/* Map cost matrix file 'path' read-only */
+/* Returns false if it is missing or malformed */
+bool CostMatrix::open(const std::filesystem::path &path)
+{
+	int fd{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st {};
+	if (fstat(fd, &st) < 0 ||
+	    static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+	auto  size{ static_cast<std::size_t>(st.st_size) };
+	void *map{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) };
+	::close(fd);
+	if (map == MAP_FAILED) {
+		return false;
+	}
+	const auto *header{ static_cast<const Header *>(map) };
+	if (header->magic != magicValue || header->version != versionValue ||
+	    header->count < 2 ||
+	    size != sizeof(Header) +
+			    header->count * header->count * sizeof(double)) {
+		munmap(map, size);
+		return false;
+	}
+	count_ = header->count;
+	data_  = std::shared_ptr<const double>(
+		 reinterpret_cast<const double *>(header + 1),
+		 [map, size](const double *) { munmap(map, size); });
+	return true;
+}
+
+/* Estimate costs between 'waypoints', in CSV order, from 'grid' */
+/* Each leg costs its great-circle length scaled by slopeCost() for the rise
+   between its ends, i.e. meters of level ground taking as long. Legs with
+   an end off the grid cost their length */
+void CostMatrix::estimate(const ElevationGrid &grid,
+			  const std::vector<std::pair<double, double> > &waypoints)
+{
+	std::size_t n{ waypoints.size() };
+	std::vector<std::optional<double> > z(n);
+	for (std::size_t i = 0; i < n; i++) {
+		z[i] = grid.at(waypoints[i]);
+	}
+	std::shared_ptr<double[]> costs{ new double[n * n] };
+	for (std::size_t i = 0; i < n; i++) {
+		for (std::size_t j = 0; j < n; j++) {
+			double d{ LegTable::distance(waypoints[i],
+						     waypoints[j]) };
+			costs[i * n + j] =
+				z[i] && z[j] ? slopeCost(d, *z[j] - *z[i]) : d;
+		}
+	}
+	count_ = n;
+	data_  = std::shared_ptr<const double>(costs, costs.get());
+}
+
+/* Whether no costs are loaded */
+bool CostMatrix::empty(void) const noexcept
+{
+	return !count_;
+}
+
+/* Number of rows and columns */
+std::size_t CostMatrix::size(void) const noexcept
+{
+	return count_;
+}
+
+/* Meters of level ground taking as long to cross as a leg of 'distance'
+   meters climbing 'rise' meters, from Tobler's hiking function normalised so
+   that level ground costs its length. Gentle descents cost slightly less
+   and steep slopes either way cost more */
+double CostMatrix::slopeCost(double distance, double rise) noexcept
+{
+	if (distance <= 0.0) {
+		return 0.0;
+	}
+	double slope{ rise / distance };
+	return distance * std::exp(3.5 * (std::abs(slope + 0.05) - 0.05));
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/* Digital elevation model in ESRI ASCII grid format, with x in degrees of
+   longitude and y in degrees of latitude. Rows run north to south */
+class ElevationGrid {
+    public:
+	bool load(const std::filesystem::path &);
+	std::optional<double>
+	at(const std::pair<double, double> &) const noexcept;
+
+    private:
+	std::size_t ncols_{ 0 };	/* Columns */
+	std::size_t nrows_{ 0 };	/* Rows */
+	double	    x0_{ 0.0 };		/* Longitude of first column */
+	double	    y0_{ 0.0 };		/* Latitude of last row */
+	double	    cell_{ 0.0 };	/* Cell size in degrees */
+	double	    nodata_{ -9999.0 }; /* Value of missing cells */
+	std::vector<double> z_; /* Elevations in meters of cell centres,
+				   row-major */
+};
+
+/* Asymmetric traversal costs between a mission's waypoints, e.g. seconds,
+   with uphill legs dearer than the same legs downhill. Indexed by CSV row,
+   row 0 being the starting position. Read from a memory-mapped binary file,
+   or estimated from an ElevationGrid. Copies share one matrix */
+class CostMatrix {
+    public:
+	bool open(const std::filesystem::path &);
+	void estimate(const ElevationGrid &,
+		      const std::vector<std::pair<double, double> > &);
+	bool empty(void) const noexcept;
+	std::size_t size(void) const noexcept;
+
+	/* Cost of travelling from CSV row 'from' to CSV row 'to' */
+	double operator()(std::size_t from, std::size_t to) const noexcept
+	{
+		return data_.get()[from * count_ + to];
+	}
+
+	static double slopeCost(double, double) noexcept;
+
+    private:
+	/* Fixed-size file header, followed by 'count' rows of 'count' costs as
+	   doubles, row 'from' holding the cost to each 'to' */
+	struct Header {
+		std::uint32_t magic;   /* "AWCM" */
+		std::uint32_t version; /* Layout version */
+		std::uint64_t count;   /* Waypoints including starting
+					  position */
+	};
+
+	static constexpr std::uint32_t magicValue{ 0x4d435741 }; /* "AWCM" */
+	static constexpr std::uint32_t versionValue{ 1 };
+
+	std::shared_ptr<const double> data_;	    /* Costs, mapped or owned */
+	std::size_t		      count_{ 0 }; /* Rows and columns */
+};
@@ -0,0 +1,260 @@
+#include "decompose.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "heuristic.hpp"
+#include "navframe.hpp"
+
+/* Constructor */
+ClusterDecomposer::ClusterDecomposer(SubSolver subSolver)
+	: subSolver_{ std::move(subSolver) },
+	  clusters_{ 0 },
+	  used_{ 0 },
+	  timeLimit_{ 0 }
+{
+}
+
+/* Setter for number of clusters, 0 to choose from mission size */
+void ClusterDecomposer::setClusters(std::size_t clusters) noexcept
+{
+	clusters_ = clusters;
+}
+
+/* Setter for time limit on polishing the stitched tour, 0 for none */
+void ClusterDecomposer::setTimeLimit(std::chrono::milliseconds limit) noexcept
+{
+	timeLimit_ = limit;
+}
+
+/* Number of non-empty clusters the last solve used */
+std::size_t ClusterDecomposer::clusterCount(void) const noexcept
+{
+	return used_;
+}
+
+/* Solve tour over 'waypoints' */
+/* Returns visiting order as indices into 'waypoints', starting at the
+   starting position 0 */
+std::vector<std::size_t>
+ClusterDecomposer::solve(const std::vector<std::pair<double, double> > &waypoints)
+{
+	std::size_t n{ waypoints.size() };
+	if (n <= 3) {
+		std::vector<std::size_t> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		used_ = 1;
+		return order;
+	}
+	frame_.anchor(waypoints[0]);
+	points_.clear();
+	points_.reserve(n);
+	for (const auto &p : waypoints) {
+		points_.push_back(frame_.toLocal(p));
+	}
+	/* About sqrt(n/2) clusters of sqrt(2n) waypoints if not given */
+	std::size_t k{ clusters_ ? clusters_ :
+				   static_cast<std::size_t>(std::lround(
+					   std::sqrt(n / 2.0))) };
+	auto clusters{ cluster(std::clamp<std::size_t>(k, 1, n / 2)) };
+	used_ = clusters.size();
+	/* Put cluster of starting position, and starting position, first */
+	auto home{ std::find_if(clusters.begin(), clusters.end(),
+				[](const auto &c) {
+					return std::ranges::find(c, 0) !=
+					       c.end();
+				}) };
+	std::iter_swap(clusters.begin(), home);
+	std::iter_swap(clusters[0].begin(), std::ranges::find(clusters[0], 0));
+	/* Solve each cluster's closed tour in parallel */
+	std::vector<std::vector<std::size_t> > cycles(clusters.size());
+	std::atomic<std::size_t>	       next{ 0 };
+	auto worker{ [&](void) {
+		for (std::size_t c = next++; c < clusters.size(); c = next++) {
+			std::vector<std::pair<double, double> > part{};
+			for (std::size_t i : clusters[c]) {
+				part.push_back(waypoints[i]);
+			}
+			auto order{ solvePart(part) };
+			for (auto &i : order) {
+				i = clusters[c][i];
+			}
+			cycles[c] = std::move(order);
+		}
+	} };
+	unsigned threads{ std::max(std::thread::hardware_concurrency(), 1U) };
+	std::vector<std::jthread> pool{};
+	for (unsigned i = 0; i < threads && i < clusters.size(); i++) {
+		pool.emplace_back(worker);
+	}
+	pool.clear(); /* Join workers */
+	/* Order clusters by a tour over their centroids */
+	std::vector<std::pair<double, double> > centroids{};
+	for (const auto &c : clusters) {
+		LocalFrame::Point sum{ 0.0, 0.0 };
+		for (std::size_t i : c) {
+			sum.first += points_[i].first;
+			sum.second += points_[i].second;
+		}
+		auto size{ static_cast<double>(c.size()) };
+		centroids.push_back(frame_.toGeodetic(
+			{ sum.first / size, sum.second / size }));
+	}
+	auto clusterOrder{ solvePart(centroids) };
+	/* Walk clusters in order, entering each at its waypoint nearest the
+	   previous exit and leaving by the tour neighbour of the entry that
+	   is cheaper counting the hop onward */
+	auto nearest{ [&](std::size_t from, const std::vector<std::size_t> &c) {
+		return *std::ranges::min_element(c, {}, [&](std::size_t i) {
+			return LocalFrame::distanceSq(points_[from], points_[i]);
+		});
+	} };
+	std::vector<std::size_t> order{};
+	order.reserve(n);
+	std::size_t entry{ 0 };
+	for (std::size_t idx = 0; idx < clusterOrder.size(); idx++) {
+		const auto &cycle{ cycles[clusterOrder[idx]] };
+		std::size_t m{ cycle.size() };
+		std::size_t p{ static_cast<std::size_t>(
+			std::ranges::find(cycle, entry) - cycle.begin()) };
+		/* Next cluster, or none to return to starting position */
+		const std::vector<std::size_t> *ahead{
+			idx + 1 < clusterOrder.size() ?
+				&clusters[clusterOrder[idx + 1]] :
+				nullptr
+		};
+		/* Cost of leaving by 'exit' relative to the closed tour */
+		auto cost{ [&](std::size_t exit) {
+			std::size_t to{ ahead ? nearest(exit, *ahead) : 0 };
+			return dist(exit, to) - dist(entry, exit);
+		} };
+		/* Forward ends at predecessor of entry, backward at
+		   successor */
+		bool forward{ m < 3 || cost(cycle[(p + m - 1) % m]) <=
+					       cost(cycle[(p + 1) % m]) };
+		for (std::size_t s = 0; s < m; s++) {
+			order.push_back(
+				cycle[forward ? (p + s) % m : (p + m - s) % m]);
+		}
+		if (ahead) {
+			entry = nearest(order.back(), *ahead);
+		}
+	}
+	/* Polish seams and any poor cluster choices */
+	TourHeuristic polish{};
+	polish.setTimeLimit(timeLimit_);
+	return polish.improve(waypoints, order);
+}
+
+/* Helper method to group waypoints into at most 'k' clusters by k-means with
+   k-means++ seeding */
+/* Returns non-empty clusters as lists of waypoint indices */
+std::vector<std::vector<std::size_t> > ClusterDecomposer::cluster(std::size_t k)
+{
+	std::size_t		       n{ points_.size() };
+	std::mt19937_64		       rng{ 1 };
+	std::vector<LocalFrame::Point> centres{ points_[0] };
+	std::vector<double>	       nearestSq(n);
+	for (std::size_t i = 0; i < n; i++) {
+		nearestSq[i] = LocalFrame::distanceSq(points_[i], centres[0]);
+	}
+	/* Seed each further centre with probability by squared distance */
+	while (centres.size() < k) {
+		std::discrete_distribution<std::size_t> pick(nearestSq.begin(),
+							      nearestSq.end());
+		double total{ std::accumulate(nearestSq.begin(),
+					      nearestSq.end(), 0.0) };
+		if (total <= 0.0) { /* Fewer distinct points than k */
+			break;
+		}
+		centres.push_back(points_[pick(rng)]);
+		for (std::size_t i = 0; i < n; i++) {
+			nearestSq[i] = std::min(
+				nearestSq[i], LocalFrame::distanceSq(
+						      points_[i], centres.back()));
+		}
+	}
+	/* Lloyd iterations until assignments settle */
+	std::vector<std::size_t> label(n, 0);
+	for (int iter = 0; iter < 50; iter++) {
+		bool changed{ false };
+		for (std::size_t i = 0; i < n; i++) {
+			double	    best{ std::numeric_limits<double>::max() };
+			std::size_t which{ 0 };
+			for (std::size_t c = 0; c < centres.size(); c++) {
+				double d{ LocalFrame::distanceSq(points_[i],
+								 centres[c]) };
+				if (d < best) {
+					best  = d;
+					which = c;
+				}
+			}
+			changed	 = changed || label[i] != which;
+			label[i] = which;
+		}
+		if (!changed && iter) {
+			break;
+		}
+		std::vector<LocalFrame::Point> sums(centres.size(), { 0.0, 0.0 });
+		std::vector<std::size_t>       counts(centres.size(), 0);
+		for (std::size_t i = 0; i < n; i++) {
+			sums[label[i]].first += points_[i].first;
+			sums[label[i]].second += points_[i].second;
+			counts[label[i]]++;
+		}
+		for (std::size_t c = 0; c < centres.size(); c++) {
+			if (counts[c]) {
+				auto size{ static_cast<double>(counts[c]) };
+				centres[c] = { sums[c].first / size,
+					       sums[c].second / size };
+			}
+		}
+	}
+	std::vector<std::vector<std::size_t> > clusters(centres.size());
+	for (std::size_t i = 0; i < n; i++) {
+		clusters[label[i]].push_back(i);
+	}
+	std::erase_if(clusters, [](const auto &c) { return c.empty(); });
+	return clusters;
+}
+
+/* Helper method to solve closed tour over 'part' with the sub-solver,
+   falling back to the builtin heuristic if it fails */
+std::vector<std::size_t> ClusterDecomposer::solvePart(
+	const std::vector<std::pair<double, double> > &part) const
+{
+	std::vector<std::size_t> order(part.size());
+	std::iota(order.begin(), order.end(), 0);
+	/* Any order of three or fewer stops is optimal */
+	if (part.size() <= 3) {
+		return order;
+	}
+	auto		  solved{ subSolver_(part) };
+	std::vector<bool> seen(part.size(), false);
+	bool		  valid{ solved.size() == part.size() };
+	for (std::size_t i : solved) {
+		if (!valid || i >= part.size() || seen[i]) {
+			valid = false;
+			break;
+		}
+		seen[i] = true;
+	}
+	if (!valid) {
+		TourHeuristic fallback{};
+		return fallback.solve(part);
+	}
+	/* Rotate to start at index 0 */
+	std::rotate_copy(solved.begin(), std::ranges::find(solved, 0),
+			 solved.end(), order.begin());
+	return order;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "navframe.hpp"
+
+/* Hierarchical solver for large clustered missions. Waypoints are grouped
+   by k-means on projected coordinates, each cluster's tour and the order of
+   clusters are solved by a sub-solver, cluster tours are opened at entry and
+   exit points chosen toward their neighbours and stitched together, and the
+   result is polished with 2-opt. Clusters are solved in parallel, so a
+   mission of tight groups far apart costs a handful of small solves rather
+   than one large one */
+class ClusterDecomposer {
+    public:
+	/* Solves a closed tour over waypoints, returning visiting order
+	   starting at index 0. Called from several threads at once */
+	using SubSolver = std::function<std::vector<std::size_t>(
+		const std::vector<std::pair<double, double> > &)>;
+
+	explicit ClusterDecomposer(SubSolver);
+
+	void	    setClusters(std::size_t) noexcept;
+	void	    setTimeLimit(std::chrono::milliseconds) noexcept;
+	std::size_t clusterCount(void) const noexcept;
+	std::vector<std::size_t>
+	solve(const std::vector<std::pair<double, double> > &);
+
+    private:
+	SubSolver		       subSolver_; /* Solver of parts */
+	std::size_t		       clusters_;  /* Clusters requested, 0
+						      to choose by size */
+	std::size_t		       used_;	   /* Clusters in last solve */
+	std::chrono::milliseconds      timeLimit_; /* Limit on polishing, 0
+						      for none */
+	LocalFrame		       frame_;	   /* Frame about starting
+						      position */
+	std::vector<LocalFrame::Point> points_;	   /* Projected waypoints */
+
+	double dist(std::size_t a, std::size_t b) const noexcept
+	{
+		return std::sqrt(
+			LocalFrame::distanceSq(points_[a], points_[b]));
+	}
+
+	std::vector<std::vector<std::size_t> > cluster(std::size_t);
+	std::vector<std::size_t>
+	solvePart(const std::vector<std::pair<double, double> > &) const;
+};
@@ -0,0 +1,97 @@
+#include "generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "navframe.hpp"
+
+/* Constructor */
+MissionGenerator::MissionGenerator(std::uint64_t seed) noexcept
+	: rng_{ seed }
+{
+}
+
+/* Names of shapes generate() accepts */
+const std::vector<std::string> &MissionGenerator::shapes(void)
+{
+	static const std::vector<std::string> names{ "line", "spiral",
+						     "clusters", "oneside",
+						     "allaround" };
+	return names;
+}
+
+/* Generate mission of 'shape' with 'n' waypoints including the starting
+   position */
+/* Returns empty if 'shape' is unknown */
+std::vector<std::pair<double, double> >
+MissionGenerator::generate(std::string_view shape, std::size_t n)
+{
+	std::uniform_real_distribution<double> unit{ 0.0, 1.0 };
+	std::normal_distribution<double>	normal{ 0.0, 1.0 };
+	/* Waypoints are placed in meters east and north of start */
+	std::vector<LocalFrame::Point> points{};
+	points.reserve(n);
+	points.emplace_back(0.0, 0.0);
+	if (shape == "line") {
+		/* Scattered 500 m about a 50 km line to the north-east */
+		for (std::size_t i = 1; i < n; i++) {
+			double t{ unit(rng_) * 50000.0 };
+			double off{ normal(rng_) * 500.0 };
+			points.emplace_back(t * 0.64 + off * 0.77,
+					    t * 0.77 - off * 0.64);
+		}
+	} else if (shape == "spiral") {
+		/* Three turns out to 22 km, evenly spaced along the arm */
+		for (std::size_t i = 1; i < n; i++) {
+			double t{ static_cast<double>(i) / static_cast<double>(n) };
+			double θ{ t * 6.0 * std::numbers::pi };
+			double r{ t * 22000.0 };
+			points.emplace_back(r * std::sin(θ) + normal(rng_) * 20.0,
+					    r * std::cos(θ) + normal(rng_) * 20.0);
+		}
+	} else if (shape == "clusters") {
+		/* About cube root of n clusters of 600 m spread within 6 km */
+		auto clusters{ std::max<std::size_t>(
+			2, static_cast<std::size_t>(std::cbrt(n))) };
+		std::vector<LocalFrame::Point> centres{};
+		for (std::size_t k = 0; k < clusters; k++) {
+			centres.emplace_back((unit(rng_) - 0.5) * 12000.0,
+					     (unit(rng_) - 0.5) * 12000.0);
+		}
+		for (std::size_t i = 1; i < n; i++) {
+			const auto &c{ centres[i % clusters] };
+			points.emplace_back(c.first + normal(rng_) * 600.0,
+					    c.second + normal(rng_) * 600.0);
+		}
+	} else if (shape == "oneside") {
+		/* Uniform over 10 km square north of start */
+		for (std::size_t i = 1; i < n; i++) {
+			points.emplace_back((unit(rng_) - 0.5) * 10000.0,
+					    unit(rng_) * 10000.0);
+		}
+	} else if (shape == "allaround") {
+		/* Uniform over 20 km square centred on start */
+		for (std::size_t i = 1; i < n; i++) {
+			points.emplace_back((unit(rng_) - 0.5) * 20000.0,
+					    (unit(rng_) - 0.5) * 20000.0);
+		}
+	} else {
+		return {};
+	}
+	LocalFrame frame{};
+	frame.anchor(start_);
+	std::vector<std::pair<double, double> > waypoints{};
+	waypoints.reserve(points.size());
+	for (const auto &p : points) {
+		waypoints.push_back(frame.toGeodetic(p));
+	}
+	return waypoints;
+}
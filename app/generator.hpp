@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/* Seeded generator of synthetic missions in the shapes of tests/csv (line,
+   spiral, clusters, oneside and allaround) at any number of waypoints. The
+   first waypoint is the starting position, and each shape keeps the extent
+   of its test files, so larger missions are denser rather than wider */
+class MissionGenerator {
+    public:
+	explicit MissionGenerator(std::uint64_t seed = 1) noexcept;
+
+	std::vector<std::pair<double, double> > generate(std::string_view,
+							 std::size_t);
+
+	static const std::vector<std::string> &shapes(void);
+
+    private:
+	static constexpr std::pair<double, double> start_{
+		32.3988, -110.997
+	}; /* Starting position of test files */
+	std::mt19937_64 rng_; /* Waypoint generator */
+};
@@ -1,5 +1,7 @@
 #include "gps.hpp"
 
+#include <poll.h>
+
 #include <cerrno>
 #include <chrono>
 #include <cstring>
@@ -15,7 +17,9 @@ GPSClient::GPSClient(const char *host, const char *port, int timeout_us,
 					       connected_{ false },
 					       timeout_us_{ timeout_us },
 					       max_tries_{ max_tries },
-					       last_ts_{ 0.0 }
+					       last_ts_{ 0.0 },
+					       wakeFd_{ -1 },
+					       woken_{ false }
 {
 	/* Allocates memory for gps_data_t data_ */
 	std::memset(&data_, 0, sizeof(data_));
@@ -63,10 +67,10 @@ void GPSClient::stopStream(void)
 }
 
 /* Fix-reading with appropriate error handling */
-std::optional<GPSFix> GPSClient::readFix(void)
+std::optional<GPSFix> GPSClient::readFix(int timeout_us)
 {
 	/* Poll GPS daemon's socket for data */
-	if (gps_waiting(&data_, timeout_us_)) {
+	if (waitData(timeout_us)) {
 		/* Read GPS data into data_ struct */
 		if (gps_read(&data_, nullptr, 0) < 0) {
 			/* If gps_read() returns less than 0, report error and
@@ -89,7 +93,11 @@ std::optional<GPSFix> GPSClient::readFix(void)
 			last_ts_ = fix_ts;
 			return GPSFix{ data_.fix.latitude,
 				       data_.fix.longitude,
-				       data_.fix.track };
+				       data_.fix.track,
+				       data_.fix.speed,
+				       fix_ts,
+				       data_.fix.epx,
+				       data_.fix.epy };
 		}
 	}
 	/* Either timeout has expired and no data/not enough data has arrived
@@ -99,23 +107,101 @@ std::optional<GPSFix> GPSClient::readFix(void)
 }
 
 /* Wrapper for readFix(), attemps to get 2D fix reading */
+/* A wait following one that was woken keeps its deadline, so signal loss is
+   still reported in time however often waits are woken */
 std::optional<GPSFix> GPSClient::waitReadFix(void)
 {
+	using namespace std::chrono;
 	/* If GPSClient is not connected, return nullopt */
 	if (!connected_)
 		return std::nullopt;
+	if (!woken_) {
+		giveUp_ = steady_clock::now() +
+			  max_tries_ * (microseconds(timeout_us_) + seconds(1));
+	}
+	woken_	  = false;
 	int tries = max_tries_;
 	/* Try to get GPS fix */
-	while (tries) {
-		auto optFix{ readFix() };
+	while (tries && steady_clock::now() < giveUp_) {
+		auto optFix{ readFix(timeout_us_) };
 		if (optFix) {
 			/* If we get 2D fix, then return fix */
 			return optFix;
 		}
 		tries--;
 		/* Rate limit tries */
-		std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+		if (woken_ || sleepWake(1000)) {
+			return std::nullopt;
+		}
 	}
 	/* If we don't get any 2D fix max_tries_, return nullopt */
 	return std::nullopt;
 }
+
+/* Non-blocking read, drains messages already buffered from the GPS daemon and
+   returns the freshest 2D fix among them, if any */
+std::optional<GPSFix> GPSClient::pollFix(void)
+{
+	/* If GPSClient is not connected, return nullopt */
+	if (!connected_)
+		return std::nullopt;
+	std::optional<GPSFix> latest{};
+	/* Bound drain so a flooding daemon cannot stall the caller */
+	for (int i = 0; i < 16 && gps_waiting(&data_, 0); i++) {
+		auto optFix{ readFix(0) };
+		if (optFix) {
+			latest.emplace(*optFix);
+		}
+	}
+	return latest;
+}
+
+/* Setter for descriptor that cuts waitReadFix() short when it becomes
+   readable, e.g. a server's, so its requests are not held up by the GPS */
+void GPSClient::setWakeFd(int fd) noexcept
+{
+	wakeFd_ = fd;
+}
+
+/* Whether last waitReadFix() returned early because wake descriptor became
+   readable, rather than because the GPS gave no fix */
+bool GPSClient::woken(void) const noexcept
+{
+	return woken_;
+}
+
+/* Wait up to 'timeout_us' for data from the GPS daemon, polling its socket
+   together with the wake descriptor, if set */
+/* Returns false on timeout or wake */
+bool GPSClient::waitData(int timeout_us)
+{
+	if (wakeFd_ < 0) {
+		return gps_waiting(&data_, timeout_us);
+	}
+	/* Messages already buffered by libgps do not show on the socket */
+	if (gps_waiting(&data_, 0)) {
+		return true;
+	}
+	pollfd fds[]{ { data_.gps_fd, POLLIN, 0 }, { wakeFd_, POLLIN, 0 } };
+	if (poll(fds, 2, timeout_us / 1000) <= 0) {
+		return false;
+	}
+	if (fds[1].revents) {
+		woken_ = true;
+		return false;
+	}
+	return true;
+}
+
+/* Sleep 'ms' milliseconds, or until wake descriptor becomes readable */
+/* Returns true if woken */
+bool GPSClient::sleepWake(int ms)
+{
+	if (wakeFd_ < 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+		return false;
+	}
+	pollfd fd{ wakeFd_, POLLIN, 0 };
+	woken_ = poll(&fd, 1, ms) > 0;
+	return woken_;
+}
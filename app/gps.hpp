@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <optional>
 extern "C" {
 #include <gps.h>
@@ -9,6 +10,10 @@ struct GPSFix {
 	const double latitude;	/* GPS latitude */
 	const double longitude; /* GPS longitude */
 	const double heading;	/* GPS bearing from true North */
+	const double speed;	/* GPS speed over ground in meters per second */
+	const double time;	/* GPS fix timestamp in seconds since epoch */
+	const double epx;	/* GPS longitude error estimate in meters */
+	const double epy;	/* GPS latitude error estimate in meters */
 };
 
 class GPSClient {
@@ -24,6 +29,9 @@ class GPSClient {
 	void stopStream(void);
 
 	std::optional<GPSFix> waitReadFix(void);
+	std::optional<GPSFix> pollFix(void);
+	void		      setWakeFd(int) noexcept;
+	bool		      woken(void) const noexcept;
 
     private:
 	gps_data_t  data_;	 /* GPS data struct */
@@ -35,6 +43,14 @@ class GPSClient {
 	const int   max_tries_;	 /* Max attempts to poll GPS */
 	double	    last_ts_;	 /* Last GPS poll timestamp to retrieve fresh
 				 data */
+	int	    wakeFd_;	 /* Descriptor cutting waits short when
+				    readable, -1 for none */
+	bool	    woken_;	 /* Last wait was cut short by wakeFd_ */
+	std::chrono::steady_clock::time_point giveUp_; /* Deadline of wait,
+							  kept across woken
+							  waits */
 
-	std::optional<GPSFix> readFix(void);
+	std::optional<GPSFix> readFix(int);
+	bool		      waitData(int);
+	bool		      sleepWake(int);
 };
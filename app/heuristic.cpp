@@ -0,0 +1,862 @@
+#include "heuristic.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "navframe.hpp"
+#include "route.hpp"
+
+/* Call 'f' with every cell index on the square ring at Chebyshev distance
+   'r' about cell ('cx', 'cy'), clipped to an 'nx' by 'ny' grid */
+template <typename F>
+static void forRing(std::size_t cx, std::size_t cy, std::size_t r,
+		    std::size_t nx, std::size_t ny, F &&f)
+{
+	auto x0{ static_cast<std::ptrdiff_t>(cx) - static_cast<std::ptrdiff_t>(r) };
+	auto y0{ static_cast<std::ptrdiff_t>(cy) - static_cast<std::ptrdiff_t>(r) };
+	auto x1{ static_cast<std::ptrdiff_t>(cx + r) };
+	auto y1{ static_cast<std::ptrdiff_t>(cy + r) };
+	auto w{ static_cast<std::ptrdiff_t>(nx) };
+	auto h{ static_cast<std::ptrdiff_t>(ny) };
+	for (auto y = std::max<std::ptrdiff_t>(y0, 0); y <= std::min(y1, h - 1);
+	     y++) {
+		/* Whole row on top and bottom edges, else just both ends */
+		auto step{ y == y0 || y == y1 ? 1 : x1 - x0 };
+		for (auto x = x0; x <= x1; x += step) {
+			if (x >= 0 && x < w) {
+				f(static_cast<std::size_t>(y) * nx +
+				  static_cast<std::size_t>(x));
+			}
+		}
+	}
+}
+
+/* Reverse 'tour' between positions 'i' and 'j' inclusive, or the
+   complement if shorter, which leaves the same cycle, keeping 'pos' the
+   inverse of 'tour' */
+static void reverseSpan(std::vector<std::uint32_t> &tour,
+			std::vector<std::uint32_t> &pos, std::size_t i,
+			std::size_t j)
+{
+	std::size_t n{ tour.size() };
+	std::size_t len{ (j + n - i) % n + 1 };
+	if (2 * len > n) {
+		std::tie(i, j) = std::pair{ (j + 1) % n, (i + n - 1) % n };
+		len	       = n - len;
+	}
+	for (std::size_t k = 0; k < len / 2; k++) {
+		std::swap(tour[i], tour[j]);
+		pos[tour[i]] = static_cast<std::uint32_t>(i);
+		pos[tour[j]] = static_cast<std::uint32_t>(j);
+		i	     = (i + 1) % n;
+		j	     = (j + n - 1) % n;
+	}
+}
+
+/* Move the 'len' waypoints of 'tour' from position 'first' on to between
+   position 'after' and its successor, reversed if 'flip', shifting the
+   shorter run of waypoints between them */
+static void moveSegment(std::vector<std::uint32_t> &tour,
+			std::vector<std::uint32_t> &pos, std::size_t first,
+			std::size_t len, std::size_t after, bool flip)
+{
+	std::size_t   n{ tour.size() };
+	std::uint32_t seg[3];
+	for (std::size_t t = 0; t < len; t++) {
+		seg[t] = tour[(first + t) % n];
+	}
+	/* Waypoints from segment's successor to 'after', and from after's
+	   successor to segment's predecessor */
+	std::size_t ahead{ (after + 2 * n - first - len) % n + 1 };
+	std::size_t behind{ n - len - ahead };
+	std::size_t at{};
+	auto	    put{ [&](std::size_t i, std::uint32_t c) {
+		       tour[i % n] = c;
+		       pos[c]	   = static_cast<std::uint32_t>(i % n);
+	} };
+	if (ahead <= behind) {
+		for (std::size_t t = 0; t < ahead; t++) {
+			put(first + t, tour[(first + len + t) % n]);
+		}
+		at = first + ahead;
+	} else {
+		for (std::size_t t = behind; t-- > 0;) {
+			put(after + 1 + len + t, tour[(after + 1 + t) % n]);
+		}
+		at = after + 1;
+	}
+	for (std::size_t t = 0; t < len; t++) {
+		put(at + t, seg[flip ? len - 1 - t : t]);
+	}
+}
+
+/* Setter for time limit on improvement, 0 for none */
+/* The nearest neighbour tour is always completed, so a tour is returned
+   however short the limit */
+void TourHeuristic::setTimeLimit(std::chrono::milliseconds limit) noexcept
+{
+	timeLimit_ = limit;
+}
+
+/* Setter for turn penalty in meters */
+/* A heading change of angle a at a waypoint costs penalty * (1 - cos a) / 2,
+   i.e. nothing going straight on and the whole penalty for reversing. No
+   turn is charged at the starting position. Cannot be negative */
+void TourHeuristic::setTurnPenalty(double penalty) noexcept
+{
+	turnPenalty_ = std::max(penalty, 0.0);
+}
+
+/* Solve tour over 'waypoints' */
+/* Returns visiting order as indices into 'waypoints', starting at the
+   starting position 0 */
+std::vector<std::size_t>
+TourHeuristic::solve(const std::vector<std::pair<double, double> > &waypoints)
+{
+	auto start{ std::chrono::steady_clock::now() };
+	std::vector<std::size_t> order(waypoints.size());
+	std::iota(order.begin(), order.end(), 0);
+	/* Any order of three or fewer stops is optimal */
+	if (waypoints.size() <= 3) {
+		return order;
+	}
+	prepare(waypoints);
+	auto tour{ nearestNeighbourTour() };
+	twoOpt(tour, deadline(start));
+	if (turnPenalty_ > 0.0) {
+		turnOpt(tour, deadline(start));
+	}
+	return rotate(tour);
+}
+
+/* Improve visiting 'order' over 'waypoints' by 2-opt, and against turn
+   penalty if set, e.g. a tour stitched together from parts or solved by
+   another solver */
+/* Returns improved order, starting at the starting position 0 */
+std::vector<std::size_t>
+TourHeuristic::improve(const std::vector<std::pair<double, double> > &waypoints,
+		       const std::vector<std::size_t>		    &order)
+{
+	auto start{ std::chrono::steady_clock::now() };
+	if (waypoints.size() <= 3 || order.size() != waypoints.size()) {
+		return order;
+	}
+	prepare(waypoints);
+	std::vector<std::uint32_t> tour(order.begin(), order.end());
+	twoOpt(tour, deadline(start));
+	if (turnPenalty_ > 0.0) {
+		turnOpt(tour, deadline(start));
+	}
+	return rotate(tour);
+}
+
+/* Solve tour against asymmetric 'costs', an 'n' by 'n' row-major matrix
+   holding the cost of travelling from i to j at i * n + j */
+/* Returns visiting order starting at the starting position 0 */
+std::vector<std::size_t>
+TourHeuristic::solveAsymmetric(const std::vector<double> &costs, std::size_t n)
+{
+	auto start{ std::chrono::steady_clock::now() };
+	std::vector<std::size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	if (n < 3 || costs.size() != n * n) {
+		return order;
+	}
+	/* Nearest neighbour tour by outgoing cost */
+	std::vector<bool> visited(n, false);
+	visited[0] = true;
+	for (std::size_t i = 1; i < n; i++) {
+		const double *row{ costs.data() + order[i - 1] * n };
+		std::size_t   best{ n };
+		for (std::size_t j = 0; j < n; j++) {
+			if (!visited[j] && (best == n || row[j] < row[best])) {
+				best = j;
+			}
+		}
+		order[i]      = best;
+		visited[best] = true;
+	}
+	asymmetricOpt(costs, order, deadline(start));
+	return order;
+}
+
+/* Improve visiting 'order' against asymmetric 'costs', see
+   solveAsymmetric(), e.g. a tour solved by another solver */
+/* Returns improved order, starting at the starting position 0 */
+std::vector<std::size_t>
+TourHeuristic::improveAsymmetric(const std::vector<double> &costs,
+				 std::size_t n, const std::vector<std::size_t> &order)
+{
+	auto start{ std::chrono::steady_clock::now() };
+	if (n < 3 || order.size() != n || costs.size() != n * n) {
+		return order;
+	}
+	auto tour{ order };
+	std::ranges::rotate(tour, std::ranges::find(tour, 0));
+	asymmetricOpt(costs, tour, deadline(start));
+	return tour;
+}
+
+/* Helper method to project 'waypoints' about the starting position and
+   index them for neighbour search */
+void TourHeuristic::prepare(const std::vector<std::pair<double, double> > &waypoints)
+{
+	LocalFrame frame{};
+	frame.anchor(waypoints[0]);
+	points_.clear();
+	points_.reserve(waypoints.size());
+	for (const auto &p : waypoints) {
+		points_.push_back(frame.toLocal(p));
+	}
+	buildGrid();
+	buildCandidates();
+}
+
+/* Helper method to get deadline of improvement begun at 'start' */
+std::chrono::steady_clock::time_point
+TourHeuristic::deadline(std::chrono::steady_clock::time_point start) const noexcept
+{
+	return timeLimit_.count() ? start + timeLimit_ :
+				    std::chrono::steady_clock::time_point::max();
+}
+
+/* Helper method to rotate 'tour' to start at the starting position */
+std::vector<std::size_t>
+TourHeuristic::rotate(const std::vector<std::uint32_t> &tour)
+{
+	std::vector<std::size_t> order(tour.size());
+	auto first{ std::find(tour.begin(), tour.end(), 0) };
+	std::rotate_copy(tour.begin(), first, tour.end(), order.begin());
+	return order;
+}
+
+/* Length in meters of closed tour visiting 'waypoints' in 'order' */
+double
+TourHeuristic::tourLength(const std::vector<std::pair<double, double> > &waypoints,
+			  const std::vector<std::size_t> &order) noexcept
+{
+	double length{ 0.0 };
+	for (std::size_t i = 0; i < order.size(); i++) {
+		length += LegTable::distance(
+			waypoints[order[i]],
+			waypoints[order[(i + 1) % order.size()]]);
+	}
+	return length;
+}
+
+/* Cost of closed tour visiting 'order' against asymmetric 'costs', see
+   solveAsymmetric() */
+double TourHeuristic::tourCost(const std::vector<double> &costs, std::size_t n,
+			       const std::vector<std::size_t> &order) noexcept
+{
+	double cost{ 0.0 };
+	for (std::size_t i = 0; i < order.size(); i++) {
+		cost += costs[order[i] * n + order[(i + 1) % order.size()]];
+	}
+	return cost;
+}
+
+/* Turn cost in meters of closed tour visiting 'waypoints' in 'order' from
+   the starting position, see setTurnPenalty() */
+/* Each heading change is measured in a frame anchored at its waypoint */
+double
+TourHeuristic::turnCost(const std::vector<std::pair<double, double> > &waypoints,
+			const std::vector<std::size_t> &order,
+			double				penalty) noexcept
+{
+	double cost{ 0.0 };
+	if (order.size() < 3 || penalty <= 0.0) {
+		return cost;
+	}
+	LocalFrame frame{};
+	for (std::size_t i = 1; i < order.size(); i++) {
+		frame.anchor(waypoints[order[i]]);
+		auto   u{ frame.toLocal(waypoints[order[i - 1]]) };
+		auto   w{ frame.toLocal(waypoints[order[(i + 1) % order.size()]]) };
+		double norm{ std::hypot(u.first, u.second) *
+			     std::hypot(w.first, w.second) };
+		if (norm > 0.0) {
+			double cosine{ -(u.first * w.first + u.second * w.second) /
+				       norm };
+			cost += penalty * (1.0 - cosine) / 2.0;
+		}
+	}
+	return cost;
+}
+
+/* Bucket waypoints into a uniform grid of about two per cell */
+void TourHeuristic::buildGrid(void)
+{
+	auto [xMin, xMax]{ std::minmax_element(
+		points_.begin(), points_.end(),
+		[](const auto &a, const auto &b) { return a.first < b.first; }) };
+	auto [yMin, yMax]{ std::minmax_element(
+		points_.begin(), points_.end(),
+		[](const auto &a, const auto &b) { return a.second < b.second; }) };
+	minX_ = xMin->first;
+	minY_ = yMin->second;
+	double w{ xMax->first - minX_ };
+	double h{ yMax->second - minY_ };
+	auto   n{ static_cast<double>(points_.size()) };
+	/* Size cells by area, but no finer than a line of waypoints needs */
+	cell_ = std::max({ std::sqrt(w * h * 2.0 / n),
+			   std::max(w, h) * 2.0 / n, 1.0e-3 });
+	nx_   = static_cast<std::size_t>(w / cell_) + 1;
+	ny_   = static_cast<std::size_t>(h / cell_) + 1;
+	/* Counting sort of waypoints by cell */
+	cellStart_.assign(nx_ * ny_ + 1, 0);
+	for (const auto &p : points_) {
+		cellStart_[cellOf(p) + 1]++;
+	}
+	std::partial_sum(cellStart_.begin(), cellStart_.end(),
+			 cellStart_.begin());
+	cellItems_.resize(points_.size());
+	std::vector<std::uint32_t> fill(cellStart_.begin(), cellStart_.end() - 1);
+	for (std::uint32_t i = 0; i < points_.size(); i++) {
+		cellItems_[fill[cellOf(points_[i])]++] = i;
+	}
+}
+
+/* Grid cell containing 'p' */
+std::size_t TourHeuristic::cellOf(const LocalFrame::Point &p) const noexcept
+{
+	auto cx{ std::min(static_cast<std::size_t>((p.first - minX_) / cell_),
+			  nx_ - 1) };
+	auto cy{ std::min(static_cast<std::size_t>((p.second - minY_) / cell_),
+			  ny_ - 1) };
+	return cy * nx_ + cx;
+}
+
+/* Find each waypoint's k_ nearest neighbours by searching rings of cells
+   outward until no closer waypoint can remain */
+void TourHeuristic::buildCandidates(void)
+{
+	k_ = std::min(neighbours_, points_.size() - 1);
+	candidates_.resize(points_.size() * k_);
+	std::vector<std::pair<double, std::uint32_t> > best{};
+	for (std::uint32_t i = 0; i < points_.size(); i++) {
+		auto c{ cellOf(points_[i]) };
+		auto cx{ c % nx_ };
+		auto cy{ c / nx_ };
+		best.clear();
+		for (std::size_t r = 0; r <= std::max(nx_, ny_); r++) {
+			forRing(cx, cy, r, nx_, ny_, [&](std::size_t cell) {
+				for (auto s = cellStart_[cell];
+				     s < cellStart_[cell + 1]; s++) {
+					auto j{ cellItems_[s] };
+					if (j == i) {
+						continue;
+					}
+					double d{ LocalFrame::distanceSq(
+						points_[i], points_[j]) };
+					if (best.size() == k_ &&
+					    d >= best.back().first) {
+						continue;
+					}
+					if (best.size() == k_) {
+						best.pop_back();
+					}
+					best.insert(std::upper_bound(
+							    best.begin(),
+							    best.end(),
+							    std::pair{ d, j }),
+						    { d, j });
+				}
+			});
+			/* Cells beyond the next ring are at least r cells
+			   away */
+			double reach{ static_cast<double>(r) * cell_ };
+			if (best.size() == k_ && best.back().first <= reach * reach) {
+				break;
+			}
+		}
+		for (std::size_t k = 0; k < k_; k++) {
+			candidates_[i * k_ + k] = best[k].second;
+		}
+	}
+}
+
+/* Nearest neighbour tour from the starting position */
+/* The nearest unvisited waypoint is the first unvisited candidate if there
+   is one, else it is found by ring search over the cells' unvisited
+   waypoints */
+std::vector<std::uint32_t> TourHeuristic::nearestNeighbourTour(void)
+{
+	/* Unvisited waypoints of each cell are kept at the front of its span */
+	std::vector<std::uint32_t> live{ cellItems_ };
+	std::vector<std::uint32_t> liveEnd(cellStart_.begin() + 1,
+					   cellStart_.end());
+	std::vector<std::uint32_t> slot(points_.size());
+	for (std::uint32_t s = 0; s < live.size(); s++) {
+		slot[live[s]] = s;
+	}
+	std::vector<bool> visited(points_.size(), false);
+	auto		  visit{ [&](std::uint32_t p) {
+		     visited[p] = true;
+		     auto c{ cellOf(points_[p]) };
+		     auto last{ --liveEnd[c] };
+		     std::swap(live[slot[p]], live[last]);
+		     slot[live[slot[p]]] = slot[p];
+		     slot[p]		 = last;
+	} };
+	std::vector<std::uint32_t> tour{ 0 };
+	tour.reserve(points_.size());
+	visit(0);
+	while (tour.size() < points_.size()) {
+		auto cur{ tour.back() };
+		auto next{ std::numeric_limits<std::uint32_t>::max() };
+		for (std::size_t k = 0; k < k_; k++) {
+			if (!visited[candidates_[cur * k_ + k]]) {
+				next = candidates_[cur * k_ + k];
+				break;
+			}
+		}
+		if (next == std::numeric_limits<std::uint32_t>::max()) {
+			auto   c{ cellOf(points_[cur]) };
+			double bestD{ std::numeric_limits<double>::max() };
+			for (std::size_t r = 0; r <= std::max(nx_, ny_); r++) {
+				forRing(c % nx_, c / nx_, r, nx_, ny_,
+					[&](std::size_t cell) {
+						for (auto s = cellStart_[cell];
+						     s < liveEnd[cell]; s++) {
+							double d{ LocalFrame::distanceSq(
+								points_[cur],
+								points_[live[s]]) };
+							if (d < bestD) {
+								bestD = d;
+								next  = live[s];
+							}
+						}
+					});
+				double reach{ static_cast<double>(r) * cell_ };
+				if (bestD <= reach * reach) {
+					break;
+				}
+			}
+		}
+		visit(next);
+		tour.push_back(next);
+	}
+	return tour;
+}
+
+/* Improve 'tour' by 2-opt moves until none is left or 'deadline' passes */
+/* Each waypoint is tried against its candidates in both tour directions.
+   Waypoints whose neighbourhood is unchanged since they last failed to
+   improve are skipped until an edge at them changes */
+void TourHeuristic::twoOpt(std::vector<std::uint32_t>	       &tour,
+			   std::chrono::steady_clock::time_point deadline) const
+{
+	std::size_t		   n{ tour.size() };
+	std::vector<std::uint32_t> pos(n);
+	for (std::size_t i = 0; i < n; i++) {
+		pos[tour[i]] = static_cast<std::uint32_t>(i);
+	}
+	auto succ{ [&](std::uint32_t c) { return tour[(pos[c] + 1) % n]; } };
+	auto pred{ [&](std::uint32_t c) { return tour[(pos[c] + n - 1) % n]; } };
+	std::deque<std::uint32_t> queue(tour.begin(), tour.end());
+	std::vector<bool>	  queued(n, true);
+	auto			  push{ [&](std::uint32_t c) {
+		     if (!queued[c]) {
+			     queued[c] = true;
+			     queue.push_back(c);
+		     }
+	} };
+	std::size_t steps{ 0 };
+	while (!queue.empty()) {
+		/* Check deadline now and then, it costs a clock read */
+		if (++steps % 256 == 0 &&
+		    std::chrono::steady_clock::now() >= deadline) {
+			break;
+		}
+		auto a{ queue.front() };
+		queue.pop_front();
+		queued[a] = false;
+		for (int dir = 0; dir < 2; dir++) {
+			bool	      improved{ false };
+			std::uint32_t b{ dir ? pred(a) : succ(a) };
+			double	      dab{ dist(a, b) };
+			for (std::size_t k = 0; k < k_; k++) {
+				auto   c{ candidates_[a * k_ + k] };
+				double dac{ dist(a, c) };
+				/* Candidates are sorted, so no later one
+				   gains */
+				if (dac >= dab) {
+					break;
+				}
+				std::uint32_t d{ dir ? pred(c) : succ(c) };
+				if (c == b || d == a) {
+					continue;
+				}
+				/* Replace edges a-b and c-d by a-c and b-d */
+				if (dac + dist(b, d) < dab + dist(c, d) - 1e-7) {
+					if (dir) {
+						reverseSpan(tour, pos, pos[a],
+							    pos[d]);
+					} else {
+						reverseSpan(tour, pos, pos[b],
+							    pos[c]);
+					}
+					push(a);
+					push(b);
+					push(c);
+					push(d);
+					improved = true;
+					break;
+				}
+			}
+			if (improved) {
+				break;
+			}
+		}
+	}
+}
+
+/* Turn cost at 'v' coming from 'u' and leaving for 'w' */
+double TourHeuristic::turn(std::uint32_t u, std::uint32_t v,
+			   std::uint32_t w) const noexcept
+{
+	if (!v) {
+		return 0.0;
+	}
+	double ix{ points_[v].first - points_[u].first };
+	double iy{ points_[v].second - points_[u].second };
+	double ox{ points_[w].first - points_[v].first };
+	double oy{ points_[w].second - points_[v].second };
+	double norm{ std::sqrt((ix * ix + iy * iy) * (ox * ox + oy * oy)) };
+	if (norm <= 0.0) {
+		return 0.0;
+	}
+	return turnPenalty_ * (1.0 - (ix * ox + iy * oy) / norm) / 2.0;
+}
+
+/* Cost of path through 'len' waypoints 'p': its legs plus turns at all but
+   its ends */
+double TourHeuristic::pathCost(const std::uint32_t *p,
+			       std::size_t	    len) const noexcept
+{
+	double cost{ 0.0 };
+	for (std::size_t i = 0; i + 1 < len; i++) {
+		cost += dist(p[i], p[i + 1]);
+		if (i) {
+			cost += turn(p[i - 1], p[i], p[i + 1]);
+		}
+	}
+	return cost;
+}
+
+/* Improve 'tour' against distance plus turn penalty by 2-opt and Or-opt
+   moves until none is left or 'deadline' passes */
+/* A move only changes the turns at the waypoints whose neighbours change,
+   so it is scored on the short paths around them before and after. Or-opt
+   moves segments of up to segment_ waypoints, either way round, next to a
+   candidate of either end. Don't-look bits work as in twoOpt() */
+void TourHeuristic::turnOpt(std::vector<std::uint32_t>	      &tour,
+			    std::chrono::steady_clock::time_point deadline) const
+{
+	std::size_t n{ tour.size() };
+	/* Paths scored must not wrap around the tour */
+	if (n < 2 * segment_ + 4) {
+		return;
+	}
+	std::vector<std::uint32_t> pos(n);
+	for (std::size_t i = 0; i < n; i++) {
+		pos[tour[i]] = static_cast<std::uint32_t>(i);
+	}
+	auto succ{ [&](std::uint32_t c) { return tour[(pos[c] + 1) % n]; } };
+	auto pred{ [&](std::uint32_t c) { return tour[(pos[c] + n - 1) % n]; } };
+	std::deque<std::uint32_t> queue(tour.begin(), tour.end());
+	std::vector<bool>	  queued(n, true);
+	auto			  push{ [&](std::uint32_t c) {
+		     if (!queued[c]) {
+			     queued[c] = true;
+			     queue.push_back(c);
+		     }
+	} };
+	/* Short path of waypoints to score */
+	struct Path {
+		std::uint32_t nodes[2 * segment_ + 4];
+		std::size_t   len;
+
+		void add(std::initializer_list<std::uint32_t> list) noexcept
+		{
+			for (auto c : list) {
+				nodes[len++] = c;
+			}
+		}
+
+		void add(const std::uint32_t *list, std::size_t count) noexcept
+		{
+			for (std::size_t t = 0; t < count; t++) {
+				nodes[len++] = list[t];
+			}
+		}
+
+		void add(const std::vector<std::uint32_t> &tour,
+			 std::size_t first, std::size_t count) noexcept
+		{
+			for (std::size_t t = 0; t < count; t++) {
+				nodes[len++] = tour[(first + t) % tour.size()];
+			}
+		}
+	};
+	auto cost{ [&](const Path &path) {
+		return pathCost(path.nodes, path.len);
+	} };
+	/* Try 2-opt moves replacing a-b by a-c for candidates c of a */
+	auto tryTwoOpt{ [&](std::uint32_t a) {
+		for (int dir = 0; dir < 2; dir++) {
+			std::uint32_t b{ dir ? pred(a) : succ(a) };
+			for (std::size_t k = 0; k < k_; k++) {
+				auto	      c{ candidates_[a * k_ + k] };
+				std::uint32_t d{ dir ? pred(c) : succ(c) };
+				if (c == b || d == a) {
+					continue;
+				}
+				/* Same move with edges w-x and y-z forward */
+				auto [w, x, y, z]{ dir ? std::tuple{ b, a, d, c } :
+							 std::tuple{ a, b, c, d } };
+				std::uint32_t before[2][4]{
+					{ pred(w), w, x, succ(x) },
+					{ pred(y), y, z, succ(z) }
+				};
+				std::uint32_t after[2][4]{
+					{ pred(w), w, y, pred(y) },
+					{ succ(x), x, z, succ(z) }
+				};
+				if (pathCost(after[0], 4) + pathCost(after[1], 4) <
+				    pathCost(before[0], 4) +
+					    pathCost(before[1], 4) - 1e-7) {
+					reverseSpan(tour, pos, pos[x], pos[y]);
+					for (auto v : { before[0][0], w, x,
+							before[0][3], before[1][0],
+							y, z, before[1][3] }) {
+						push(v);
+					}
+					return true;
+				}
+			}
+		}
+		return false;
+	} };
+	/* Try moving segment of 'len' waypoints from position 'first' next to
+	   a candidate of either end */
+	auto tryOrOpt{ [&](std::size_t first, std::size_t len) {
+		std::uint32_t s1{ tour[first % n] };
+		std::uint32_t s2{ tour[(first + len - 1) % n] };
+		std::uint32_t p{ pred(s1) };
+		std::uint32_t q{ succ(s2) };
+		auto	      inSegment{ [&](std::uint32_t c) {
+			       return (pos[c] + n - first % n) % n < len;
+		} };
+		for (auto e : { s1, s2 }) {
+			for (std::size_t k = 0; k < k_; k++) {
+				auto c{ candidates_[e * k_ + k] };
+				if (inSegment(c)) {
+					continue;
+				}
+				/* Insert between x and y with e next to c */
+				for (int side = 0; side < 2; side++) {
+					std::uint32_t x{ side ? pred(c) : c };
+					std::uint32_t y{ side ? c : succ(c) };
+					if (x == p || inSegment(x)) {
+						continue;
+					}
+					bool flip{ (e == s1) == (side == 1) &&
+						   len > 1 };
+					std::uint32_t seg[segment_];
+					for (std::size_t t = 0; t < len; t++) {
+						seg[t] = tour[(first +
+							       (flip ? len - 1 - t :
+								       t)) %
+							      n];
+					}
+					/* Paths around the segment's old and new
+					   places, as one if they meet */
+					Path before[2]{};
+					Path after[2]{};
+					if (x == q) {
+						before[0].add({ pred(p), p });
+						before[0].add(tour, first, len);
+						before[0].add({ q, y, succ(y) });
+						after[0].add({ pred(p), p, q });
+						after[0].add(seg, len);
+						after[0].add({ y, succ(y) });
+					} else if (y == p) {
+						before[0].add({ pred(x), x, p });
+						before[0].add(tour, first, len);
+						before[0].add({ q, succ(q) });
+						after[0].add({ pred(x), x });
+						after[0].add(seg, len);
+						after[0].add({ p, q, succ(q) });
+					} else {
+						before[0].add({ pred(p), p });
+						before[0].add(tour, first, len);
+						before[0].add({ q, succ(q) });
+						after[0].add({ pred(p), p, q,
+							       succ(q) });
+						before[1].add({ pred(x), x, y,
+								succ(y) });
+						after[1].add({ pred(x), x });
+						after[1].add(seg, len);
+						after[1].add({ y, succ(y) });
+					}
+					if (cost(after[0]) + cost(after[1]) <
+					    cost(before[0]) + cost(before[1]) -
+						    1e-7) {
+						moveSegment(tour, pos, first % n,
+							    len, pos[x], flip);
+						for (auto v : { p, q, s1, s2, x,
+								y }) {
+							push(v);
+						}
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	} };
+	std::size_t steps{ 0 };
+	while (!queue.empty()) {
+		/* Check deadline now and then, it costs a clock read */
+		if (++steps % 64 == 0 &&
+		    std::chrono::steady_clock::now() >= deadline) {
+			break;
+		}
+		auto a{ queue.front() };
+		queue.pop_front();
+		queued[a] = false;
+		if (tryTwoOpt(a)) {
+			continue;
+		}
+		/* Segments starting or ending at a */
+		for (std::size_t len = 1; len <= segment_; len++) {
+			if (tryOrOpt(pos[a], len) ||
+			    (len > 1 && tryOrOpt(pos[a] + n + 1 - len, len))) {
+				break;
+			}
+		}
+	}
+}
+
+/* Improve 'tour', starting at 0, against asymmetric 'costs' by 2-opt and
+   Or-opt moves that add an edge between a waypoint and one of its nearest
+   neighbours, until none is left or 'deadline' passes */
+/* Reversing a path changes the cost of every edge on it, so 2-opt is scored
+   from prefix sums of the tour's edges forward and backward, rebuilt after
+   each move. Or-opt moves segments of up to segment_ waypoints without
+   reversing them. The starting position stays first */
+void TourHeuristic::asymmetricOpt(
+	const std::vector<double> &costs, std::vector<std::size_t> &tour,
+	std::chrono::steady_clock::time_point deadline) const
+{
+	std::size_t n{ tour.size() };
+	auto	    c{ [&](std::size_t a, std::size_t b) {
+		   return costs[a * n + b];
+	} };
+	/* Candidates nearest in the cheaper direction */
+	std::size_t		 k{ std::min(neighbours_, n - 1) };
+	std::vector<std::size_t> candidates(n * k);
+	std::vector<std::size_t> others(n - 1);
+	for (std::size_t a = 0; a < n; a++) {
+		for (std::size_t b = 0, t = 0; b < n; b++) {
+			if (b != a) {
+				others[t++] = b;
+			}
+		}
+		auto near{ [&](std::size_t b) {
+			return std::min(c(a, b), c(b, a));
+		} };
+		std::ranges::partial_sort(others, others.begin() + k, {}, near);
+		std::copy_n(others.begin(), k, candidates.begin() + a * k);
+	}
+	/* Positions, and costs of tour up to each position forward and
+	   backward, position n being the return to 0 */
+	std::vector<std::size_t> pos(n);
+	std::vector<double>	 fwd(n + 1), bwd(n + 1);
+	auto			 at{ [&](std::size_t p) { return tour[p % n]; } };
+	auto			 rebuild{ [&](void) {
+		for (std::size_t p = 0; p < n; p++) {
+			pos[tour[p]] = p;
+			fwd[p + 1]   = fwd[p] + c(tour[p], at(p + 1));
+			bwd[p + 1]   = bwd[p] + c(at(p + 1), tour[p]);
+		}
+	} };
+	rebuild();
+	/* Reverse positions i to j, 1 <= i < j < n */
+	auto twoOpt{ [&](std::size_t i, std::size_t j) {
+		if (i < 1 || i >= j || j >= n) {
+			return false;
+		}
+		std::size_t a{ tour[i - 1] }, u{ tour[i] }, v{ tour[j] },
+			b{ at(j + 1) };
+		double delta{ c(a, v) + c(u, b) + (bwd[j] - bwd[i]) - c(a, u) -
+			      c(v, b) - (fwd[j] - fwd[i]) };
+		if (delta >= -1e-9) {
+			return false;
+		}
+		std::reverse(tour.begin() + i, tour.begin() + j + 1);
+		return true;
+	} };
+	/* Move positions i to i + len - 1, 1 <= i, to between positions q and
+	   q + 1 */
+	auto orOpt{ [&](std::size_t i, std::size_t len, std::size_t q) {
+		if (i < 1 || i + len > n || (q + 1 >= i && q < i + len)) {
+			return false;
+		}
+		std::size_t p{ tour[i - 1] }, s1{ tour[i] },
+			s2{ tour[i + len - 1] }, next{ at(i + len) },
+			x{ tour[q] }, y{ at(q + 1) };
+		double delta{ c(p, next) + c(x, s1) + c(s2, y) - c(p, s1) -
+			      c(s2, next) - c(x, y) };
+		if (delta >= -1e-9) {
+			return false;
+		}
+		auto first{ tour.begin() + static_cast<std::ptrdiff_t>(i) };
+		auto last{ first + static_cast<std::ptrdiff_t>(len) };
+		auto to{ tour.begin() + static_cast<std::ptrdiff_t>(q) + 1 };
+		if (q >= i) {
+			std::rotate(first, last, to);
+		} else {
+			std::rotate(to, first, last);
+		}
+		return true;
+	} };
+	bool improved{ true };
+	while (improved) {
+		improved = false;
+		for (std::size_t a = 0; a < n; a++) {
+			if (std::chrono::steady_clock::now() >= deadline) {
+				return;
+			}
+			for (std::size_t t = 0; t < k; t++) {
+				std::size_t v{ candidates[a * k + t] };
+				/* Add edge a-v, then edge v-a */
+				bool moved{ twoOpt(pos[a] + 1, pos[v]) ||
+					    twoOpt(pos[v], pos[a] - 1) };
+				for (std::size_t len = 1;
+				     !moved && len <= segment_; len++) {
+					moved = orOpt(pos[v], len, pos[a]) ||
+						(pos[v] + 1 >= len &&
+						 orOpt(pos[v] + 1 - len, len,
+						       (pos[a] + n - 1) % n));
+				}
+				if (moved) {
+					rebuild();
+					improved = true;
+				}
+			}
+		}
+	}
+}
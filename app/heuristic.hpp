@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "navframe.hpp"
+
+/* In-process tour heuristic, the 'builtin' solver backend. Waypoints are
+   projected into a local frame and bucketed in a uniform grid, a nearest
+   neighbour tour is built from the starting position, then improved by
+   2-opt over each waypoint's nearest neighbours with don't-look bits. Tours
+   are typically within a few percent of linkern's, in O(N log N) time and
+   O(N) memory. With a turn penalty, the tour is then refined by 2-opt and
+   Or-opt against distance plus the penalty of each heading change. Against
+   an asymmetric cost matrix, a nearest neighbour tour is improved by 2-opt,
+   costing reversed paths from prefix sums, and Or-opt */
+class TourHeuristic {
+    public:
+	void setTimeLimit(std::chrono::milliseconds) noexcept;
+	void setTurnPenalty(double) noexcept;
+
+	std::vector<std::size_t>
+	solve(const std::vector<std::pair<double, double> > &);
+	std::vector<std::size_t>
+	improve(const std::vector<std::pair<double, double> > &,
+		const std::vector<std::size_t> &);
+
+	std::vector<std::size_t> solveAsymmetric(const std::vector<double> &,
+						 std::size_t);
+	std::vector<std::size_t>
+	improveAsymmetric(const std::vector<double> &, std::size_t,
+			  const std::vector<std::size_t> &);
+
+	static double tourLength(const std::vector<std::pair<double, double> > &,
+				 const std::vector<std::size_t> &) noexcept;
+	static double tourCost(const std::vector<double> &, std::size_t,
+			       const std::vector<std::size_t> &) noexcept;
+	static double turnCost(const std::vector<std::pair<double, double> > &,
+			       const std::vector<std::size_t> &, double) noexcept;
+
+    private:
+	static constexpr std::size_t neighbours_{ 8 }; /* Candidates per
+							  waypoint */
+
+	static constexpr std::size_t segment_{ 3 }; /* Longest segment Or-opt
+						       moves */
+
+	std::chrono::milliseconds timeLimit_{ 0 }; /* Time limit, 0 for none */
+	double turnPenalty_{ 0.0 }; /* Meters charged for reversing heading at
+				       a waypoint, 0 for distance only */
+	std::vector<LocalFrame::Point> points_;	   /* Projected waypoints */
+	double			       minX_;	   /* Grid origin */
+	double			       minY_;	   /* Grid origin */
+	double			       cell_;	   /* Grid cell size in
+						      meters */
+	std::size_t		       nx_;	   /* Grid columns */
+	std::size_t		       ny_;	   /* Grid rows */
+	std::vector<std::uint32_t>     cellStart_; /* Offset of each cell's
+						      waypoints, nx_*ny_+1
+						      entries */
+	std::vector<std::uint32_t>     cellItems_; /* Waypoints by cell */
+	std::vector<std::uint32_t>     candidates_; /* Nearest neighbours by
+						       distance, k_ per
+						       waypoint */
+	std::size_t		       k_;	    /* Candidates per
+						       waypoint */
+
+	double dist(std::uint32_t a, std::uint32_t b) const noexcept
+	{
+		return std::sqrt(
+			LocalFrame::distanceSq(points_[a], points_[b]));
+	}
+
+	void prepare(const std::vector<std::pair<double, double> > &);
+	std::chrono::steady_clock::time_point
+		deadline(std::chrono::steady_clock::time_point) const noexcept;
+	static std::vector<std::size_t>
+	rotate(const std::vector<std::uint32_t> &);
+	void			   buildGrid(void);
+	std::size_t		   cellOf(const LocalFrame::Point &) const noexcept;
+	void			   buildCandidates(void);
+	std::vector<std::uint32_t> nearestNeighbourTour(void);
+	void twoOpt(std::vector<std::uint32_t> &,
+		    std::chrono::steady_clock::time_point) const;
+	double turn(std::uint32_t, std::uint32_t, std::uint32_t) const noexcept;
+	double pathCost(const std::uint32_t *, std::size_t) const noexcept;
+	void   turnOpt(std::vector<std::uint32_t> &,
+		       std::chrono::steady_clock::time_point) const;
+	void   asymmetricOpt(const std::vector<double> &,
+			     std::vector<std::size_t> &,
+			     std::chrono::steady_clock::time_point) const;
+};
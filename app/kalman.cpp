@@ -0,0 +1,138 @@
+#include "kalman.hpp"
+
+#include <cstddef>
+
+/* Constructor */
+KalmanFilter::KalmanFilter(double accelNoise, double velocitySigma) noexcept
+	: x_{},
+	  P_{},
+	  accelNoise_{ accelNoise },
+	  velocitySigma_{ velocitySigma },
+	  initialised_{ false }
+{
+}
+
+/* Discard estimate, next update() re-initialises from its measurement */
+void KalmanFilter::reset(void) noexcept
+{
+	x_	     = {};
+	P_	     = {};
+	initialised_ = false;
+}
+
+/* Whether filter holds an estimate */
+bool KalmanFilter::initialised(void) const noexcept
+{
+	return initialised_;
+}
+
+/* Propagate state 'dt' seconds with F = [I dt·I; 0 I] and white acceleration
+   process noise */
+void KalmanFilter::predict(double dt) noexcept
+{
+	if (!initialised_ || dt <= 0.0) {
+		return;
+	}
+	/* x = F x */
+	x_[0] += dt * x_[2];
+	x_[1] += dt * x_[3];
+	/* P = F P Fᵀ, first rows (F P) then columns ((F P) Fᵀ) */
+	for (std::size_t j = 0; j < N; j++) {
+		P_[0][j] += dt * P_[2][j];
+		P_[1][j] += dt * P_[3][j];
+	}
+	for (std::size_t i = 0; i < N; i++) {
+		P_[i][0] += dt * P_[i][2];
+		P_[i][1] += dt * P_[i][3];
+	}
+	/* P += Q, per axis q·[dt³/3 dt²/2; dt²/2 dt] */
+	double q11{ accelNoise_ * dt * dt * dt / 3.0 };
+	double q12{ accelNoise_ * dt * dt / 2.0 };
+	double q22{ accelNoise_ * dt };
+	for (std::size_t a = 0; a < 2; a++) {
+		P_[a][a] += q11;
+		P_[a][a + 2] += q12;
+		P_[a + 2][a] += q12;
+		P_[a + 2][a + 2] += q22;
+	}
+}
+
+/* Fuse position measurement '{e, n}' with standard deviations '{σe, σn}' in
+   meters, H = [I 0] */
+void KalmanFilter::update(double e, double n, double σe, double σn) noexcept
+{
+	/* Initialise from first measurement */
+	if (!initialised_) {
+		x_	     = { e, n, 0.0, 0.0 };
+		P_	     = {};
+		P_[0][0]     = σe * σe;
+		P_[1][1]     = σn * σn;
+		P_[2][2]     = velocitySigma_ * velocitySigma_;
+		P_[3][3]     = velocitySigma_ * velocitySigma_;
+		initialised_ = true;
+		return;
+	}
+	/* Innovation y = z - H x and its covariance S = H P Hᵀ + R */
+	double y0{ e - x_[0] };
+	double y1{ n - x_[1] };
+	double s00{ P_[0][0] + σe * σe };
+	double s01{ P_[0][1] };
+	double s10{ P_[1][0] };
+	double s11{ P_[1][1] + σn * σn };
+	double det{ s00 * s11 - s01 * s10 };
+	if (det <= 0.0) {
+		return;
+	}
+	/* S⁻¹ */
+	double i00{ s11 / det };
+	double i01{ -s01 / det };
+	double i10{ -s10 / det };
+	double i11{ s00 / det };
+	/* K = P Hᵀ S⁻¹ */
+	std::array<std::array<double, 2>, N> K{};
+	for (std::size_t i = 0; i < N; i++) {
+		K[i][0] = P_[i][0] * i00 + P_[i][1] * i10;
+		K[i][1] = P_[i][0] * i01 + P_[i][1] * i11;
+	}
+	/* x += K y */
+	for (std::size_t i = 0; i < N; i++) {
+		x_[i] += K[i][0] * y0 + K[i][1] * y1;
+	}
+	/* P -= K H P, H P being the first two rows of P */
+	Matrix HP{};
+	HP[0] = P_[0];
+	HP[1] = P_[1];
+	for (std::size_t i = 0; i < N; i++) {
+		for (std::size_t j = 0; j < N; j++) {
+			P_[i][j] -= K[i][0] * HP[0][j] + K[i][1] * HP[1][j];
+		}
+	}
+	/* Keep P symmetric against rounding drift */
+	for (std::size_t i = 0; i < N; i++) {
+		for (std::size_t j = i + 1; j < N; j++) {
+			double avg{ 0.5 * (P_[i][j] + P_[j][i]) };
+			P_[i][j] = avg;
+			P_[j][i] = avg;
+		}
+	}
+}
+
+/* Translate position estimate by '{de, dn}' meters when re-anchoring the
+   frame it is expressed in; covariance is unaffected */
+void KalmanFilter::shift(double de, double dn) noexcept
+{
+	x_[0] += de;
+	x_[1] += dn;
+}
+
+/* Getter for x_ */
+const KalmanFilter::Vector &KalmanFilter::state(void) const noexcept
+{
+	return x_;
+}
+
+/* Getter for P_ */
+const KalmanFilter::Matrix &KalmanFilter::covariance(void) const noexcept
+{
+	return P_;
+}
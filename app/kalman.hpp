@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/* Constant-velocity Kalman filter over local east-north position in meters.
+   State is {east, north, east velocity, north velocity}; all matrices have
+   compile-time fixed sizes so predict() and update() never allocate. */
+class KalmanFilter {
+    public:
+	static constexpr std::size_t N{ 4 }; /* State dimension */
+	using Vector			 = std::array<double, N>;
+	using Matrix			 = std::array<std::array<double, N>, N>;
+
+	/* Default white acceleration noise of 1 m/s² and initial velocity
+	   uncertainty of 10 m/s */
+	KalmanFilter(double accelNoise = 1.0, double velocitySigma = 10.0) noexcept;
+
+	void	      reset(void) noexcept;
+	bool	      initialised(void) const noexcept;
+	void	      predict(double) noexcept;
+	void	      update(double, double, double, double) noexcept;
+	void	      shift(double, double) noexcept;
+	const Vector &state(void) const noexcept;
+	const Matrix &covariance(void) const noexcept;
+
+    private:
+	Vector x_;	       /* State estimate */
+	Matrix P_;	       /* State covariance */
+	double accelNoise_;    /* Process noise spectral density in m²/s³ */
+	double velocitySigma_; /* Initial velocity standard deviation */
+	bool   initialised_;   /* Flag to mark whether first measurement has
+				  been taken */
+};
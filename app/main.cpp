@@ -6,10 +6,6 @@ int main(int argc, const char **argv)
 
 	/* Instantiate navigator with user args */
 	Navigator nav{ argc, argv };
-	/* Ask navigator to parse args and setup for execution via CLI */
-	/* Must be invoked write after Navigator initialization */
-	nav.start();
-
 	/* Set proxmity radius (meters) for determining arrival at each
 	   waypoint */
 	/* Cannot be set to less than 1.0 meters (will result to default of
@@ -26,6 +22,35 @@ int main(int argc, const char **argv)
 	/* Cannot be set to a negative value (will result to default of 0) */
 	nav.setSimulationVelocity(20.0);
 
+	/* OPTIONAL: Run per-tick navigation math in a local east-north frame */
+	/* Waypoints are projected once and each tick's bearing, distance and
+	   arrival test reduce to a few multiply-adds, with error versus the
+	   spherical formulas bounded to 0.1% */
+	nav.setNavigationFrame(true);
+
+	/* OPTIONAL: Set rate (Hz) of navigation output in GPS mode */
+	/* If set, the navigator extrapolates position between GPS fixes from
+	   the last fix's speed and heading and emits corrected bearings at this
+	   rate, re-syncing whenever a fresh fix arrives */
+	/* If not set or set to 0 (the default), output is produced once per GPS
+	   fix. Has no effect while a simulation velocity is set */
+	nav.setCommandRate(50.0);
+
+	/* OPTIONAL: Smooth GPS fixes with a constant-velocity Kalman filter */
+	/* If set, the filter's smoothed position and velocity drive navigation
+	   instead of raw fixes, weighted by gpsd's reported error estimates */
+	nav.setKalmanFilter(true);
+
+	/* OPTIONAL: Publish each output to a shared-memory command channel or
+	   a Unix domain socket command stream */
+	/* Opened by run, resume and serve with the --channel and --stream
+	   options, see setCommandChannel() and setCommandStream() */
+
+	/* Ask navigator to parse args and setup for execution via CLI */
+	/* Options given as flags or in a config file (see 'help') override the
+	   setters above */
+	nav.start();
+
 	/* Spit out downstream controller output */
 	/* Must invoke start() and set proximity radius beforehand */
 	for (auto output{ nav.getOutput() }; output; output = nav.getOutput())
@@ -0,0 +1,295 @@
+#include "mission.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <utility>
+#include <vector>
+
+/* Destructor */
+MissionState::~MissionState(void)
+{
+	close();
+}
+
+/* Bytes of state file for 'count' waypoints */
+std::size_t MissionState::fileSize(std::size_t count) noexcept
+{
+	return sizeof(Header) + count * 2 * sizeof(double) +
+	       2 * count * sizeof(std::uint64_t) +
+	       (count + 63) / 64 * sizeof(std::uint64_t);
+}
+
+/* Point section pointers into mapping 'map' of 'size' bytes */
+void MissionState::bind(void *map, std::size_t size) noexcept
+{
+	auto *bytes{ static_cast<unsigned char *>(map) };
+	map_	   = map;
+	size_	   = size;
+	header_	   = static_cast<Header *>(map);
+	waypoints_ = reinterpret_cast<double *>(bytes + sizeof(Header));
+	order_	   = reinterpret_cast<std::uint64_t *>(waypoints_ +
+						     2 * header_->count);
+	csvRows_   = order_ + header_->count;
+	visited_   = reinterpret_cast<std::atomic<std::uint64_t> *>(
+		  csvRows_ + header_->count);
+}
+
+/* Flush mapping to storage, waiting for it if 'wait', else scheduling it
+   so the caller is not stalled on slow storage */
+void MissionState::sync(bool wait) noexcept
+{
+	msync(map_, size_, wait ? MS_SYNC : MS_ASYNC);
+}
+
+/* Create state file 'path' for a solved mission and map it */
+/* 'waypoints' are as solved, 'order' is the solved visiting order and
+   'csvRows' the CSV row of each waypoint, as consolidation may merge some.
+   The file is built beside 'path' and renamed over it, so an existing state
+   file is only ever replaced by a complete one. Returns false on failure,
+   or if 'csvFile' or 'logDir' is too long to store */
+bool MissionState::create(const std::filesystem::path &path,
+			  const std::vector<std::pair<double, double> > &waypoints,
+			  const std::vector<std::size_t> &order,
+			  const std::vector<std::size_t> &csvRows,
+			  const std::filesystem::path	 &csvFile,
+			  const std::filesystem::path	 &logDir)
+{
+	close();
+	/* Paths are restored by 'resume', so they must fit whole */
+	if (csvFile.native().size() >= sizeof(Header::csvFile) ||
+	    logDir.native().size() >= sizeof(Header::logDir)) {
+		std::cerr << "Error: CSV path or log directory is too long for "
+			     "mission state, at most "
+			  << sizeof(Header::csvFile) - 1 << " bytes.\n";
+		return false;
+	}
+	std::error_code ec{};
+	std::filesystem::create_directories(path.parent_path(), ec);
+	std::filesystem::path tmp{ path.string() + ".tmp" };
+	std::size_t	      size{ fileSize(order.size()) };
+	int fd{ ::open(tmp.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC,
+		       0644) };
+	if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) < 0) {
+		std::cerr << "Error: cannot create mission state " << tmp
+			  << ".\n";
+		if (fd >= 0) {
+			::close(fd);
+		}
+		return false;
+	}
+	void *map{ mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+			0) };
+	::close(fd);
+	if (map == MAP_FAILED) {
+		std::cerr << "Error: cannot map mission state " << tmp << ".\n";
+		return false;
+	}
+	/* Fill in file, marking it valid last */
+	auto *header{ new (map) Header{} };
+	header->version = versionValue;
+	header->count	= order.size();
+	std::strncpy(header->csvFile, csvFile.c_str(),
+		     sizeof(header->csvFile) - 1);
+	std::strncpy(header->logDir, logDir.c_str(),
+		     sizeof(header->logDir) - 1);
+	bind(map, size);
+	for (std::size_t i = 0; i < waypoints.size(); i++) {
+		waypoints_[2 * i]     = waypoints[i].first;
+		waypoints_[2 * i + 1] = waypoints[i].second;
+	}
+	for (std::size_t i = 0; i < order.size(); i++) {
+		order_[i]   = order[i];
+		csvRows_[i] = csvRows.at(i);
+	}
+	for (std::size_t w = 0; w < (order.size() + 63) / 64; w++) {
+		new (&visited_[w]) std::atomic<std::uint64_t>{ 0 };
+	}
+	update(1, waypoints.at(order.at(0)));
+	header->magic = magicValue;
+	sync(true);
+	std::filesystem::rename(tmp, path, ec);
+	if (ec) {
+		std::cerr << "Error: cannot write mission state " << path
+			  << ".\n";
+		close();
+		return false;
+	}
+	return true;
+}
+
+/* Map existing state file 'path' */
+/* Returns false if there is no valid state file */
+bool MissionState::open(const std::filesystem::path &path)
+{
+	close();
+	int fd{ ::open(path.c_str(), O_RDWR | O_CLOEXEC) };
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st {};
+	if (fstat(fd, &st) < 0 ||
+	    static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+	auto  size{ static_cast<std::size_t>(st.st_size) };
+	void *map{ mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+			0) };
+	::close(fd);
+	if (map == MAP_FAILED) {
+		return false;
+	}
+	const auto *header{ static_cast<const Header *>(map) };
+	if (header->magic != magicValue || header->version != versionValue ||
+	    header->count < 2 || size != fileSize(header->count)) {
+		munmap(map, size);
+		return false;
+	}
+	bind(map, size);
+	return true;
+}
+
+/* Unmap state file, if open */
+void MissionState::close(void) noexcept
+{
+	if (map_) {
+		munmap(map_, size_);
+		map_	   = nullptr;
+		size_	   = 0;
+		header_	   = nullptr;
+		waypoints_ = nullptr;
+		order_	   = nullptr;
+		csvRows_   = nullptr;
+		visited_   = nullptr;
+	}
+}
+
+/* Whether state file is open */
+bool MissionState::isOpen(void) const noexcept
+{
+	return map_;
+}
+
+/* Record tick's next destination and position */
+void MissionState::update(std::size_t			   nextDest,
+			  const std::pair<double, double> &position) noexcept
+{
+	auto now{ std::chrono::system_clock::now().time_since_epoch() };
+	header_->nextDest.store(nextDest, std::memory_order_relaxed);
+	header_->latitude.store(std::bit_cast<std::uint64_t>(position.first),
+				std::memory_order_relaxed);
+	header_->longitude.store(std::bit_cast<std::uint64_t>(position.second),
+				 std::memory_order_relaxed);
+	header_->timestamp.store(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(now)
+			.count(),
+		std::memory_order_relaxed);
+}
+
+/* Record arrival at tour position 'i' and schedule sync to storage */
+/* Called on the navigation thread, so writeback is not waited for */
+void MissionState::markVisited(std::size_t i) noexcept
+{
+	visited_[i / 64].fetch_or(std::uint64_t{ 1 } << (i % 64),
+				  std::memory_order_relaxed);
+	sync(false);
+}
+
+/* Record completion of tour and schedule sync to storage */
+void MissionState::complete(void) noexcept
+{
+	header_->completed.store(1, std::memory_order_relaxed);
+	sync(false);
+}
+
+/* Waypoints as solved, see csvRows() */
+std::vector<std::pair<double, double> > MissionState::waypoints(void) const
+{
+	std::vector<std::pair<double, double> > waypoints(header_->count);
+	for (std::size_t i = 0; i < waypoints.size(); i++) {
+		waypoints[i] = { waypoints_[2 * i], waypoints_[2 * i + 1] };
+	}
+	return waypoints;
+}
+
+/* Solved visiting order */
+std::vector<std::size_t> MissionState::order(void) const
+{
+	return { order_, order_ + header_->count };
+}
+
+/* CSV row of each waypoint */
+std::vector<std::size_t> MissionState::csvRows(void) const
+{
+	return { csvRows_, csvRows_ + header_->count };
+}
+
+/* Mission CSV path */
+std::filesystem::path MissionState::csvFile(void) const
+{
+	return std::string{ header_->csvFile,
+			    strnlen(header_->csvFile,
+				    sizeof(header_->csvFile)) };
+}
+
+/* Log directory, empty if not logging */
+std::filesystem::path MissionState::logDir(void) const
+{
+	return std::string{ header_->logDir,
+			    strnlen(header_->logDir, sizeof(header_->logDir)) };
+}
+
+/* Tour index of next destination */
+std::size_t MissionState::nextDest(void) const noexcept
+{
+	return header_->nextDest.load(std::memory_order_relaxed) %
+	       header_->count;
+}
+
+/* Last recorded position */
+std::pair<double, double> MissionState::position(void) const noexcept
+{
+	return { std::bit_cast<double>(
+			 header_->latitude.load(std::memory_order_relaxed)),
+		 std::bit_cast<double>(
+			 header_->longitude.load(std::memory_order_relaxed)) };
+}
+
+/* Whether tour position 'i' has been visited */
+bool MissionState::visited(std::size_t i) const noexcept
+{
+	return visited_[i / 64].load(std::memory_order_relaxed) >> (i % 64) & 1;
+}
+
+/* Whether tour has completed */
+bool MissionState::completed(void) const noexcept
+{
+	return header_->completed.load(std::memory_order_relaxed);
+}
+
+/* Default state file path, under $XDG_STATE_HOME or ~/.local/state */
+std::filesystem::path MissionState::defaultPath(void)
+{
+	std::filesystem::path base{};
+	if (const char *state{ std::getenv("XDG_STATE_HOME") };
+	    state && *state) {
+		base = state;
+	} else if (const char *home{ std::getenv("HOME") }; home && *home) {
+		base = std::filesystem::path{ home } / ".local" / "state";
+	} else {
+		base = std::filesystem::temp_directory_path();
+	}
+	return base / "awns-rpi5" / "mission.state";
+}
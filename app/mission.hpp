@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+/* Mission state kept in a small memory-mapped file, so an interrupted
+   mission can be resumed without prompts or re-solving. The file holds a
+   header, the waypoints, the solved visiting order, the CSV row of each
+   waypoint and a bitmap of visited waypoints. Per-tick fields are plain
+   atomic stores into the mapping, which survive a process crash as soon as
+   they are made. The file is synced to storage on creation, and writeback
+   is scheduled without waiting at each arrival, so slow storage never
+   stalls a tick and a power loss costs at most what the kernel had yet to
+   write back */
+class MissionState {
+    public:
+	MissionState(void) noexcept = default;
+	~MissionState(void);
+	MissionState(const MissionState &)	      = delete;
+	MissionState &operator=(const MissionState &) = delete;
+
+	bool create(const std::filesystem::path &,
+		    const std::vector<std::pair<double, double> > &,
+		    const std::vector<std::size_t> &,
+		    const std::vector<std::size_t> &,
+		    const std::filesystem::path &, const std::filesystem::path &);
+	bool open(const std::filesystem::path &);
+	void close(void) noexcept;
+	bool isOpen(void) const noexcept;
+
+	void update(std::size_t, const std::pair<double, double> &) noexcept;
+	void markVisited(std::size_t) noexcept;
+	void complete(void) noexcept;
+
+	std::vector<std::pair<double, double> > waypoints(void) const;
+	std::vector<std::size_t>		order(void) const;
+	std::vector<std::size_t>		csvRows(void) const;
+	std::filesystem::path			csvFile(void) const;
+	std::filesystem::path			logDir(void) const;
+	std::size_t				nextDest(void) const noexcept;
+	std::pair<double, double>		position(void) const noexcept;
+	bool visited(std::size_t) const noexcept;
+	bool completed(void) const noexcept;
+
+	static std::filesystem::path defaultPath(void);
+
+    private:
+	/* Fixed-size file header, followed by 'count' waypoints as latitude,
+	   longitude doubles, 'count' 64-bit tour order indices, 'count' 64-bit
+	   CSV rows of the waypoints and a visited bitmap of 64-bit words
+	   indexed by tour position */
+	struct Header {
+		std::uint32_t		   magic;	/* "AWMS" once valid */
+		std::uint32_t		   version;	/* Layout version */
+		std::uint64_t		   count;	/* Waypoints in tour */
+		char			   csvFile[256]; /* Mission CSV path */
+		char			   logDir[256];	 /* Log directory */
+		std::atomic<std::uint64_t> nextDest;	/* Tour index of next
+							   destination */
+		std::atomic<std::uint64_t> latitude;	/* Last position, bits of
+							   double */
+		std::atomic<std::uint64_t> longitude;	/* Last position, bits of
+							   double */
+		std::atomic<std::int64_t>  timestamp;	/* Nanoseconds since Unix
+							   epoch of last update */
+		std::atomic<std::uint32_t> completed;	/* Nonzero once tour has
+							   completed */
+	};
+
+	static constexpr std::uint32_t magicValue{ 0x534d5741 }; /* "AWMS" */
+	static constexpr std::uint32_t versionValue{ 2 };
+
+	void	   *map_{ nullptr }; /* Mapped file */
+	std::size_t size_{ 0 };	     /* Mapped bytes */
+	Header	   *header_{ nullptr };
+	double	   *waypoints_{ nullptr };
+	std::uint64_t		   *order_{ nullptr };
+	std::uint64_t		   *csvRows_{ nullptr };
+	std::atomic<std::uint64_t> *visited_{ nullptr };
+
+	static std::size_t fileSize(std::size_t) noexcept;
+	void		   bind(void *, std::size_t) noexcept;
+	void		   sync(bool) noexcept;
+};
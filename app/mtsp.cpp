@@ -0,0 +1,136 @@
+#include "mtsp.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "route.hpp"
+
+/* Constructor */
+/* 'giantOrder' is a solved visiting order of all 'waypoints', which is
+   rotated so the depot, waypoint 0, comes first */
+FleetPartitioner::FleetPartitioner(
+	const std::vector<std::pair<double, double> > &waypoints,
+	const std::vector<std::size_t>		      &giantOrder)
+	: waypoints_{ waypoints }
+{
+	auto depot{ std::find(giantOrder.begin(), giantOrder.end(), 0) };
+	if (depot == giantOrder.end()) {
+		return;
+	}
+	/* Walk tour from just after depot back round to just before it */
+	for (auto it{ std::next(depot) }; it != giantOrder.end(); ++it) {
+		seq_.push_back(*it);
+	}
+	for (auto it{ giantOrder.begin() }; it != depot; ++it) {
+		seq_.push_back(*it);
+	}
+	depotDist_.resize(seq_.size());
+	stepDist_.resize(seq_.size());
+	for (std::size_t i = 0; i < seq_.size(); i++) {
+		depotDist_[i] = LegTable::distance(waypoints_[0],
+						   waypoints_[seq_[i]]);
+		stepDist_[i] =
+			i + 1 < seq_.size() ?
+				LegTable::distance(waypoints_[seq_[i]],
+						   waypoints_[seq_[i + 1]]) :
+				0.0;
+	}
+}
+
+/* Greedily cut seq_ into segments whose routes stay within 'limit' meters */
+/* Returns number of segments, or max if a single waypoint exceeds the limit.
+   If 'cuts' is given, it receives the start index of each segment */
+std::size_t FleetPartitioner::greedy(double		       limit,
+				     std::vector<std::size_t> *cuts) const
+{
+	std::size_t segments{ 0 };
+	std::size_t i{ 0 };
+	while (i < seq_.size()) {
+		if (2 * depotDist_[i] > limit) {
+			return std::numeric_limits<std::size_t>::max();
+		}
+		if (cuts) {
+			cuts->push_back(i);
+		}
+		/* Extend segment while its route stays within limit */
+		double path{ depotDist_[i] };
+		std::size_t j{ i };
+		while (j + 1 < seq_.size() &&
+		       path + stepDist_[j] + depotDist_[j + 1] <= limit) {
+			path += stepDist_[j];
+			j++;
+		}
+		segments++;
+		i = j + 1;
+	}
+	return segments;
+}
+
+/* Partition mission across 'vehicles' vehicles */
+/* Returns one route per vehicle, each a visiting order of waypoint indices
+   starting at the depot. Never returns more routes than non-depot
+   waypoints */
+std::vector<std::vector<std::size_t> >
+FleetPartitioner::partition(std::size_t vehicles) const
+{
+	vehicles = std::clamp<std::size_t>(vehicles, 1, seq_.size());
+	if (seq_.empty()) {
+		return {};
+	}
+	/* Bottleneck lies between the farthest single waypoint's round trip
+	   and the whole giant tour */
+	double lo{ 2 * *std::max_element(depotDist_.begin(), depotDist_.end()) };
+	double hi{ depotDist_.front() + depotDist_.back() };
+	for (double step : stepDist_) {
+		hi += step;
+	}
+	hi = std::max(hi, lo);
+	/* Binary search to within a centimetre */
+	for (int iter = 0; iter < 100 && hi - lo > 0.01; iter++) {
+		double mid{ (lo + hi) / 2 };
+		if (greedy(mid, nullptr) <= vehicles) {
+			hi = mid;
+		} else {
+			lo = mid;
+		}
+	}
+	std::vector<std::size_t> cuts{};
+	greedy(hi, &cuts);
+	cuts.push_back(seq_.size());
+	/* Use every vehicle by splitting the largest segments, which cannot
+	   lengthen any route */
+	while (cuts.size() - 1 < vehicles) {
+		std::size_t widest{ 0 };
+		for (std::size_t s = 1; s + 1 < cuts.size(); s++) {
+			if (cuts[s + 1] - cuts[s] >
+			    cuts[widest + 1] - cuts[widest]) {
+				widest = s;
+			}
+		}
+		cuts.insert(cuts.begin() + widest + 1,
+			    (cuts[widest] + cuts[widest + 1]) / 2);
+	}
+	/* Assemble routes */
+	std::vector<std::vector<std::size_t> > routes(cuts.size() - 1);
+	for (std::size_t s = 0; s + 1 < cuts.size(); s++) {
+		routes[s].push_back(0);
+		routes[s].insert(routes[s].end(), seq_.begin() + cuts[s],
+				 seq_.begin() + cuts[s + 1]);
+	}
+	return routes;
+}
+
+/* Closed length in meters of a route of waypoint indices */
+double FleetPartitioner::routeLength(const std::vector<std::size_t> &route) const
+{
+	double length{ 0.0 };
+	for (std::size_t i = 0; i < route.size(); i++) {
+		length += LegTable::distance(
+			waypoints_[route[i]],
+			waypoints_[route[(i + 1) % route.size()]]);
+	}
+	return length;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/* Min-max multi-vehicle partitioning (mTSP) of a mission. A solved single
+   tour (the "giant tour") starting at the depot, waypoint 0, is split into
+   contiguous segments, one per vehicle, each driven as depot → segment →
+   depot, minimising the longest route. Extending a segment never shortens its
+   route (triangle inequality), so the optimal bottleneck is found by binary
+   search over route length with a greedy feasibility check. */
+class FleetPartitioner {
+    public:
+	FleetPartitioner(const std::vector<std::pair<double, double> > &,
+			 const std::vector<std::size_t> &);
+
+	std::vector<std::vector<std::size_t> > partition(std::size_t) const;
+	double routeLength(const std::vector<std::size_t> &) const;
+
+    private:
+	const std::vector<std::pair<double, double> >
+		&waypoints_;	      /* Waypoints in CSV order */
+	std::vector<std::size_t> seq_; /* Giant tour without depot */
+	std::vector<double> depotDist_; /* Distance from depot to seq_[i] */
+	std::vector<double> stepDist_;	/* Distance from seq_[i] to
+					   seq_[i + 1] */
+
+	std::size_t greedy(double, std::vector<std::size_t> *) const;
+};
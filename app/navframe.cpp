@@ -0,0 +1,78 @@
+#include "navframe.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+/* Constructor */
+LocalFrame::LocalFrame(double tolerance) noexcept
+	: anchor_{ 0.0, 0.0 },
+	  kx_{ 1.0 },
+	  ky_{ 1.0 },
+	  tolerance_{ tolerance },
+	  radius_{ 0.0 },
+	  radiusSq_{ 0.0 }
+{
+}
+
+/* Set relative error tolerance, takes effect on next anchor() */
+void LocalFrame::setTolerance(double tolerance) noexcept
+{
+	tolerance_ = std::clamp(tolerance, 1.0e-9, 1.0e-1);
+}
+
+/* Anchor frame at '{latitude, longitude}' and size its radius so that the
+   bearing error bound (ρ/R)(tan|φ0| + 1), which also dominates the relative
+   distance error bound, stays within tolerance_ */
+void LocalFrame::anchor(const std::pair<double, double> &origin) noexcept
+{
+	constexpr double degToRad = std::numbers::pi / 180.0;
+	anchor_			  = origin;
+	double φ0		  = origin.first * degToRad;
+	ky_			  = earthRadius_ * degToRad;
+	/* Clamp near the poles where the frame degenerates */
+	kx_	  = ky_ * std::max(std::cos(φ0), 1.0e-6);
+	radius_	  = tolerance_ * earthRadius_ / (std::abs(std::tan(φ0)) + 1.0);
+	radiusSq_ = radius_ * radius_;
+	waypoints_.clear();
+}
+
+/* Project waypoints into the frame, must be called after anchor() */
+void LocalFrame::project(const std::vector<std::pair<double, double> > &tour)
+{
+	waypoints_.resize(tour.size());
+	std::transform(tour.begin(), tour.end(), waypoints_.begin(),
+		       [this](const auto &p) { return toLocal(p); });
+}
+
+/* Adopt waypoints projected earlier about the same anchor, e.g. from a
+   mission bundle, must be called after anchor() */
+void LocalFrame::load(std::vector<Point> waypoints) noexcept
+{
+	waypoints_ = std::move(waypoints);
+}
+
+/* Whether waypoints have been projected */
+bool LocalFrame::empty(void) const noexcept
+{
+	return waypoints_.empty();
+}
+
+/* Getter for error-bounded radius about anchor in meters */
+double LocalFrame::radius(void) const noexcept
+{
+	return radius_;
+}
+
+/* Worst-case error for two points inside the frame radius, taking the
+   latitude at the edge of the frame: relative distance error and bearing error
+   in radians are both bounded by the returned value */
+double LocalFrame::errorBound(void) const noexcept
+{
+	constexpr double degToRad = std::numbers::pi / 180.0;
+	double		 x	  = radius_ / earthRadius_;
+	double		 φ	  = std::abs(anchor_.first * degToRad) + x;
+	return x * (std::abs(std::tan(φ)) + 1.0);
+}
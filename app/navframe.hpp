@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+/* Local east-north tangent frame used for per-tick navigation math. Waypoints
+   are projected once into metres about an anchor point, after which bearing,
+   distance and arrival tests reduce to a handful of multiply-adds. */
+/* Error bound: for two points within radius ρ of the anchor at latitude φ0,
+   the relative distance error against the haversine formula is at most
+   (ρ/R)(tan|φ0| + ρ/R) and the bearing error is at most (ρ/R)(tan|φ0| + 1)
+   radians. The frame radius is derived from the requested tolerance, and
+   points outside it must fall back to the spherical formulas. */
+class LocalFrame {
+    public:
+	using Point = std::pair<double, double>; /* East, north in meters */
+
+	/* Default relative distance error tolerance (0.1%) */
+	LocalFrame(double tolerance = 1.0e-3) noexcept;
+
+	void	     anchor(const std::pair<double, double> &) noexcept;
+	void	     project(const std::vector<std::pair<double, double> > &);
+	void	     load(std::vector<Point>) noexcept;
+	void	     setTolerance(double) noexcept;
+	bool	     empty(void) const noexcept;
+	double	     radius(void) const noexcept;
+	double	     errorBound(void) const noexcept;
+	const Point &waypoint(std::size_t i) const noexcept
+	{
+		return waypoints_[i];
+	}
+
+	/* Convert {latitude, longitude} in degrees to local {east, north} */
+	Point toLocal(const std::pair<double, double> &p) const noexcept
+	{
+		return { std::remainder(p.second - anchor_.second, 360.0) * kx_,
+			 (p.first - anchor_.first) * ky_ };
+	}
+
+	/* Convert local {east, north} back to {latitude, longitude} */
+	std::pair<double, double> toGeodetic(const Point &p) const noexcept
+	{
+		double lon{ anchor_.second + p.first / kx_ };
+		return { anchor_.first + p.second / ky_,
+			 std::remainder(lon, 360.0) };
+	}
+
+	/* Whether a local point lies within the error-bounded radius */
+	bool contains(const Point &p) const noexcept
+	{
+		return p.first * p.first + p.second * p.second <= radiusSq_;
+	}
+
+	/* Squared distance in meters between two local points */
+	static double distanceSq(const Point &a, const Point &b) noexcept
+	{
+		double de{ b.first - a.first };
+		double dn{ b.second - a.second };
+		return de * de + dn * dn;
+	}
+
+	/* Bearing in degrees from true North in [0,360) from 'a' to 'b' */
+	static double bearing(const Point &a, const Point &b) noexcept
+	{
+		double deg{ std::atan2(b.first - a.first, b.second - a.second) *
+			    180.0 / std::numbers::pi };
+		return deg < 0.0 ? deg + 360.0 : deg;
+	}
+
+    private:
+	static constexpr double earthRadius_{
+		6371000.0
+	}; /* Earth's radius in meters */
+	std::pair<double, double> anchor_; /* Lat, lon of frame origin */
+	double			  kx_;	   /* Meters per degree of longitude at
+					      anchor */
+	double			  ky_;	   /* Meters per degree of latitude */
+	double	  tolerance_; /* Relative distance error tolerance */
+	double	  radius_;    /* Error-bounded radius about anchor */
+	double	  radiusSq_;  /* Squared radius for cheap containment test */
+	std::vector<Point> waypoints_; /* Projected waypoints */
+};
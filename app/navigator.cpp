@@ -1,21 +1,51 @@
 #include "navigator.hpp"
 
+#include <unistd.h>
+
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <numbers>
+#include <numeric>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include "batch.hpp"
+#include "bench.hpp"
+#include "bundle.hpp"
 #include "concorde.hpp"
+#include "costs.hpp"
+#include "generator.hpp"
 #include "gps.hpp"
+#include "mission.hpp"
+#include "mtsp.hpp"
+#include "navframe.hpp"
+#include "process.hpp"
+#include "realtime.hpp"
+#include "server.hpp"
+#include "simulator.hpp"
+#include "telemetry.hpp"
+#include "watch.hpp"
 
 /* Get navigation output for downstream controller  */
 /* If
@@ -26,7 +56,8 @@
      this returns null,
    else
    - return JSON of navigation output */
-std::optional<json> Navigator::getOutput(void)
+template <NavigatorPolicy Policy>
+std::optional<json> BasicNavigator<Policy>::getOutput(void)
 {
 	/* If navigator not ready, or proximity radius not set, return null */
 	if (!ready_) {
@@ -36,40 +67,148 @@ std::optional<json> Navigator::getOutput(void)
 		std::cerr << "error: please set proximity radius.\n";
 		return std::nullopt;
 	}
-	/* If simulation velocity is set, predict system position */
-	if (simulationVelocity_) {
+	/* Enter real-time profile on first tick, once solving is done */
+	if (realtime_.enabled() && !realtime_.active() && !offline_) {
+		realtime_.apply();
+	}
+	std::optional<json> output{};
+	interrupted_ = false;
+	/* If in offline simulation mode, simulate whole mission */
+	if (offline_) {
+		/* Call helper method for offline simulation output */
+		output = offlineOutput();
+	} else if (simulationVelocity_) { /* Predict system position */
 		/* Call helper method for simulation velocity output */
-		return simulationVelocityOutput();
+		output = simulationVelocityOutput();
+	} else if (commandRate_) { /* Extrapolate between GPS readings */
+		/* Call helper method for dead-reckoned output */
+		output = deadReckoningOutput();
 	} else { /* Generate output based on GPS reading */
 		 /* Call helper method for GPS reading output */
-		return gpsOutput();
+		output = gpsOutput();
+	}
+	/* Tick was cut short without a fix, see waitFix() */
+	if (interrupted_) {
+		return std::nullopt;
+	}
+	/* Record tick in mission state, if kept */
+	if (state_.isOpen() && output) {
+		state_.update(nextDest_, currPos_);
+	}
+	/* Publish to command channel and stream, if open */
+	if ((channel_.isOpen() || stream_.isOpen()) && !offline_) {
+		publishCommand(output);
+	}
+	/* Record tick in telemetry log, if kept */
+	if (telemetry_.isOpen() && output && !offline_) {
+		recordTelemetry(TelemetryEvent::tick,
+				std::chrono::steady_clock::now() - tickStart_);
+	}
+	/* Report tick jitter at end of mission, if measured */
+	if (!output && jitter_.count()) {
+		reportJitter();
+	}
+	return output;
+}
+
+/* Helper method to print wake-up jitter of mission's ticks and start
+   afresh */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::reportJitter(void)
+{
+	auto us{ [](std::chrono::nanoseconds ns) {
+		return static_cast<double>(ns.count()) * 1e-3;
+	} };
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1)
+	    << "(System Message) Tick jitter over " << jitter_.count()
+	    << " ticks: min " << us(jitter_.min()) << " us, mean "
+	    << us(jitter_.mean()) << " us, p50 " << us(jitter_.percentile(50))
+	    << " us, p99 " << us(jitter_.percentile(99)) << " us, p99.9 "
+	    << us(jitter_.percentile(99.9)) << " us, max "
+	    << us(jitter_.max()) << " us";
+	logPrint(oss.str(), true);
+	jitter_.reset();
+}
+
+/* Helper method to append a telemetry record of current position and
+   command */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::recordTelemetry(TelemetryEvent	      event,
+					     std::chrono::nanoseconds latency)
+{
+	using namespace std::chrono;
+	TelemetryRecord record{
+		event,
+		static_cast<std::uint32_t>(nextDest_),
+		waypointIndex(),
+		duration_cast<nanoseconds>(WallClock::now().time_since_epoch())
+			.count(),
+		latency.count(),
+		currPos_.first,
+		currPos_.second,
+		static_cast<double>(bearing_),
+		destDistance_
+	};
+	telemetry_.append(record);
+}
+
+/* Helper method to publish current command to shared-memory channel and
+   socket stream */
+/* Null 'output' ends the commands, either because the tour has completed
+   or because the GPS signal was lost, told apart by 'completed' and
+   'status' */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::publishCommand(const std::optional<json> &output)
+{
+	auto command{ getCommand() };
+	if (!output && !completed_) {
+		command.status = static_cast<std::uint32_t>(NavStatus::gpsLost);
+	}
+	if (channel_.isOpen()) {
+		channel_.publish(command);
+	}
+	if (stream_.isOpen()) {
+		stream_.publish(command,
+				output	   ? *output :
+				completed_ ? json{ { "completed", true } } :
+					     json{ { "status", "gps_lost" } });
+	}
+}
+
+/* Helper method to wait for GPS fix */
+/* Returns null if GPS signal is lost, or if the wait was cut short by the
+   position source's wake descriptor, marking the tick interrupted */
+template <NavigatorPolicy Policy>
+std::optional<GPSFix> BasicNavigator<Policy>::waitFix(void)
+{
+	auto optFix{ gps_.waitReadFix() };
+	if (!optFix && gps_.woken()) {
+		interrupted_ = true;
+	} else if (!optFix) {
+		logPrint("(System Message) GPS signal lost. Ending output.",
+			 true);
 	}
+	return optFix;
 }
 
 /* Helper method for GPS output */
-std::optional<json> Navigator::gpsOutput(void)
+template <NavigatorPolicy Policy>
+std::optional<json> BasicNavigator<Policy>::gpsOutput(void)
 {
 	/* Get GPS reading */
-	auto optFix{ gps_.waitReadFix() };
+	auto optFix{ waitFix() };
 	/* If can't get GPS reading, return null */
 	if (!optFix) {
-		logPrint("(System Message) GPS signal lost. Ending output.",
-			 true);
 		return std::nullopt;
 	}
+	tickStart_ = std::chrono::steady_clock::now();
 	/* Get current position */
 	GPSFix fix{ *optFix };
-	/* Update 'currPos_' */
-	currPos_.first	= fix.latitude;
-	currPos_.second = fix.longitude;
-	/* Get next destination */
-	auto optDest{ getDest() };
-	if (!optDest) { /* If route finished, return null */
+	/* Steer toward next destination */
+	if (!steer(fix)) { /* If route finished, return null */
 		return std::nullopt;
 	}
-	dest_ = *optDest;
-	/* Calculate direction to start heading */
-	bearing_ = calculateBearing(currPos_, dest_);
 	/* Return JSON ouput */
 	json j{
 		{ "gps_position",
@@ -77,30 +216,117 @@ std::optional<json> Navigator::gpsOutput(void)
 		    { "longitude", fix.longitude } }   },
 		{	  "bearing",	     bearing_ },
 		{  "destination",
-		  { { "waypoint", tourOrder_[nextDest_] },
+		  { { "waypoint", waypointIndex() },
 		    { "latitude", dest_.first },
 		    { "longitude", dest_.second } }    },
+		{ "progress", progressOutput() },
 		{	  "timestamp",     getTimestamp() }
 	};
+	/* Add filter estimate */
+	if (filter_) {
+		j["filter"] = filterOutput();
+	}
 	/* Print JSON and return */
 	logPrint(j.dump(2), false);
 	return j;
 }
 
-/* Helper method for simulation velocity output */
-std::optional<json> Navigator::simulationVelocityOutput(void)
+/* Steer from a GPS fix without producing output */
+/* Updates current position, advances to the next destination on arrival and
+   computes the bearing to it. Returns bearing in degrees from true North, or
+   null if the navigator is not ready or the tour has completed */
+template <NavigatorPolicy Policy>
+std::optional<double> BasicNavigator<Policy>::steer(const GPSFix &fix)
 {
-	/* Time GPS reading */
+	if (!ready_) {
+		return std::nullopt;
+	}
+	/* Update 'currPos_' and ground speed, smoothed if filtering */
+	if (filter_) {
+		currPos_ = filterFix(fix);
+		const auto &x{ kalman_.state() };
+		groundSpeed_ = std::hypot(x[2], x[3]);
+	} else {
+		currPos_.first	= fix.latitude;
+		currPos_.second = fix.longitude;
+		groundSpeed_	= std::isfinite(fix.speed) ? fix.speed : -1.0;
+	}
+	/* Get next destination */
+	auto optDest{ getDest() };
+	if (!optDest) { /* If route finished, return null */
+		return std::nullopt;
+	}
+	dest_ = *optDest;
+	/* Calculate direction to start heading */
+	bearing_ = destBearing();
+	return bearing_;
+}
+
+/* Helper method for offline simulation output */
+/* Runs the whole mission against a synthetic GPS on a virtual clock as fast
+   as the CPU allows and returns its report once, then null */
+template <NavigatorPolicy Policy>
+std::optional<json> BasicNavigator<Policy>::offlineOutput(void)
+{
+	if (reported_) {
+		return std::nullopt;
+	} else if (!simulationVelocity_) {
+		std::cerr << "Error: please set simulation velocity.\n";
+		return std::nullopt;
+	}
+	/* Mirror this navigator's settings onto a quiet in-process navigator */
+	ReplayNavigator nav{};
+	nav.setProximityRadius(proximityRadius_);
+	nav.setNavigationFrame(navFrame_);
+	nav.setKalmanFilter(filter_);
+	nav.setVerbose(false);
+	nav.loadTour(concorde_.getWaypoints(), tourOrder_);
+	/* Tick at command rate if set, else at the GPS's 1 Hz */
+	SyntheticGPS gps{ tour_.at(0) };
+	Simulator    sim{ nav, gps };
+	sim.setVelocity(simulationVelocity_);
+	sim.setTick(commandRate_ ? 1.0 / commandRate_ : 1.0);
 	auto start{ std::chrono::steady_clock::now() };
-	auto optFix{ gps_.waitReadFix() };
+	auto report{ sim.run() };
 	auto end{ std::chrono::steady_clock::now() };
+	reported_ = true;
+	/* Return JSON ouput */
+	json arrivals = json::array();
+	for (const auto &[waypoint, time] : report.arrivals) {
+		arrivals.push_back({ { "waypoint", concorde_.csvIndex(waypoint) },
+				     { "time", time } });
+	}
+	json j{
+		{ "simulation",
+		  { { "completed", report.completed },
+		    { "distance", report.distance },
+		    { "tour_length", report.tourLength },
+		    { "time", report.time },
+		    { "ticks", report.ticks },
+		    { "arrivals", arrivals },
+		    { "wall_time",
+		      std::chrono::duration<double>(end - start).count() } } },
+		{ "timestamp", getTimestamp() }
+	};
+	/* Print JSON and return */
+	logPrint(j.dump(2), false);
+	return j;
+}
+
+/* Helper method for simulation velocity output */
+template <NavigatorPolicy Policy>
+std::optional<json> BasicNavigator<Policy>::simulationVelocityOutput(void)
+{
+	/* Time GPS reading */
+	auto start{ Clock::now() };
+	auto optFix{ waitFix() };
+	auto end{ Clock::now() };
 	auto elapsed{ std::chrono::duration<double>(end - start) };
 	/* If can't get GPS reading, return null */
 	if (!optFix) {
-		logPrint("(System Message) GPS signal lost. Ending output.",
-			 true);
 		return std::nullopt;
 	}
+	tickStart_ = std::chrono::steady_clock::now();
 	/* Init GPS fix */
 	auto fix{ *optFix };
 	/* If vehicle is in motion, calculate predicted position */
@@ -114,6 +340,7 @@ std::optional<json> Navigator::simulationVelocityOutput(void)
 		/* Vehicle is set to start moving */
 		inMotion_ = true;
 	}
+	groundSpeed_ = simulationVelocity_;
 	/* Get next destination */
 	auto optDest{ getDest() };
 	if (!optDest) { /* If route finished, return null */
@@ -121,7 +348,7 @@ std::optional<json> Navigator::simulationVelocityOutput(void)
 	}
 	dest_ = *optDest;
 	/* Calculate direction to start heading */
-	bearing_ = calculateBearing(currPos_, dest_);
+	bearing_ = destBearing();
 	/* Return JSON ouput */
 	json j{
 		{ "sim_position",
@@ -133,9 +360,10 @@ std::optional<json> Navigator::simulationVelocityOutput(void)
 		{	  "velocity",  simulationVelocity_ },
 		{	  "bearing",	     bearing_ },
 		{  "destination",
-		  { { "waypoint", tourOrder_[nextDest_] },
+		  { { "waypoint", waypointIndex() },
 		    { "latitude", dest_.first },
 		    { "longitude", dest_.second } }	    },
+		{ "progress", progressOutput() },
 		{	  "timestamp",       getTimestamp() }
 	};
 	/* Print JSON and return */
@@ -143,11 +371,180 @@ std::optional<json> Navigator::simulationVelocityOutput(void)
 	return j;
 }
 
+/* Helper method for dead-reckoned output */
+/* Ticks at commandRate_ on the monotonic clock, extrapolating position from
+   the last GPS fix using its velocity, and re-syncs whenever a fresh fix
+   arrives */
+template <NavigatorPolicy Policy>
+std::optional<json> BasicNavigator<Policy>::deadReckoningOutput(void)
+{
+	using namespace std::chrono;
+	/* Wait for next tick deadline */
+	auto now{ Clock::now() };
+	if (now < nextTick_) {
+		Clock::sleepUntil(nextTick_);
+		/* Measure wake-up against deadline */
+		jitter_.record(Clock::now() - nextTick_);
+		now = nextTick_;
+	} else { /* First tick or overrun, rebase schedule without bursting */
+		if (nextTick_ != typename Clock::time_point{}) {
+			jitter_.record(now - nextTick_);
+		}
+		nextTick_ = now;
+	}
+	nextTick_ += duration_cast<typename Clock::duration>(
+		duration<double>(1.0 / commandRate_));
+	/* Re-sync on fresh fix if one is waiting */
+	if (auto optFix{ gps_.pollFix() }) {
+		resyncFix(*optFix, now);
+	} else if (!lastFix_ || now - lastFixTick_ > drHorizon_) {
+		/* If no fix yet, or extrapolated too long, block for one */
+		auto optFix{ waitFix() };
+		/* If can't get GPS reading, return null */
+		if (!optFix) {
+			return std::nullopt;
+		}
+		now = Clock::now();
+		resyncFix(*optFix, now);
+	}
+	tickStart_ = steady_clock::now();
+	/* Extrapolate current position from last fix */
+	double age{ duration<double>(now - lastFixTick_).count() };
+	currPos_ = drFrame_.toGeodetic(
+		{ drVelocity_.first * age, drVelocity_.second * age });
+	groundSpeed_ = std::hypot(drVelocity_.first, drVelocity_.second);
+	/* Get next destination */
+	auto optDest{ getDest() };
+	if (!optDest) { /* If route finished, return null */
+		return std::nullopt;
+	}
+	dest_ = *optDest;
+	/* Calculate direction to start heading */
+	bearing_ = destBearing();
+	/* Return JSON ouput */
+	json j{
+		{ "dr_position",
+		  { { "latitude", currPos_.first },
+		    { "longitude", currPos_.second } } },
+		{ "gps_position",
+		  { { "latitude", lastFix_->latitude },
+		    { "longitude", lastFix_->longitude } } },
+		{ "fix_age", age },
+		{ "bearing", bearing_ },
+		{ "destination",
+		  { { "waypoint", waypointIndex() },
+		    { "latitude", dest_.first },
+		    { "longitude", dest_.second } } },
+		{ "progress", progressOutput() },
+		{ "timestamp", getTimestamp() }
+	};
+	/* Add filter estimate */
+	if (filter_) {
+		j["filter"] = filterOutput();
+	}
+	/* Print JSON and return */
+	logPrint(j.dump(2), false);
+	return j;
+}
+
+/* Helper method to re-sync dead reckoning on a fresh fix */
+/* Velocity comes from the fix's reported speed and track if available, else
+   from displacement since the previous fix */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::resyncFix(const GPSFix		   &fix,
+				       typename Clock::time_point t)
+{
+	std::pair<double, double> pos{ fix.latitude, fix.longitude };
+	if (filter_) {
+		/* Extrapolate from smoothed position and velocity */
+		pos = filterFix(fix);
+		const auto &x{ kalman_.state() };
+		drVelocity_ = { x[2], x[3] };
+	} else if (std::isfinite(fix.speed) && std::isfinite(fix.heading)) {
+		double θ{ deg2rad(fix.heading) };
+		drVelocity_ = { fix.speed * std::sin(θ),
+				fix.speed * std::cos(θ) };
+	} else if (lastFix_ && fix.time > lastFix_->time) {
+		/* drFrame_ is still anchored at the previous fix */
+		auto   d{ drFrame_.toLocal(pos) };
+		double dt{ fix.time - lastFix_->time };
+		drVelocity_ = { d.first / dt, d.second / dt };
+	} else {
+		drVelocity_ = { 0.0, 0.0 };
+	}
+	drFrame_.anchor(pos);
+	lastFix_.emplace(fix);
+	lastFixTick_ = t;
+}
+
+/* Helper method to fuse a GPS fix into the Kalman filter */
+/* Measurement noise comes from gpsd's 95% error estimates where reported, else
+   a default for the receiver. Returns smoothed {latitude, longitude} */
+template <NavigatorPolicy Policy>
+std::pair<double, double> BasicNavigator<Policy>::filterFix(const GPSFix &fix)
+{
+	auto sigma{ [](double ep) {
+		return std::isfinite(ep) && ep > 0.0 ?
+			       std::max(ep / 1.96, 0.5) :
+			       defaultFixSigma_;
+	} };
+	std::pair<double, double> pos{ fix.latitude, fix.longitude };
+	if (!kalman_.initialised()) {
+		kfFrame_.anchor(pos);
+	} else {
+		kalman_.predict(fix.time - kfTime_);
+		/* Re-anchor frame on estimate once it leaves the frame's
+		   error-bounded radius */
+		const auto &x{ kalman_.state() };
+		if (!kfFrame_.contains({ x[0], x[1] })) {
+			kfFrame_.anchor(kfFrame_.toGeodetic({ x[0], x[1] }));
+			kalman_.shift(-x[0], -x[1]);
+		}
+	}
+	auto z{ kfFrame_.toLocal(pos) };
+	kalman_.update(z.first, z.second, sigma(fix.epx), sigma(fix.epy));
+	kfTime_ = fix.time;
+	const auto &x{ kalman_.state() };
+	return kfFrame_.toGeodetic({ x[0], x[1] });
+}
+
+/* Helper method to report smoothed state and its uncertainty */
+template <NavigatorPolicy Policy>
+json BasicNavigator<Policy>::filterOutput(void)
+{
+	const auto &x{ kalman_.state() };
+	const auto &P{ kalman_.covariance() };
+	auto	    pos{ kfFrame_.toGeodetic({ x[0], x[1] }) };
+	return json{
+		{ "latitude", pos.first },
+		{ "longitude", pos.second },
+		{ "velocity", { { "east", x[2] }, { "north", x[3] } } },
+		{ "sigma",
+		  { { "east", std::sqrt(P[0][0]) },
+		    { "north", std::sqrt(P[1][1]) } } }
+	};
+}
+
+/* Helper method to report route progress */
+template <NavigatorPolicy Policy>
+json BasicNavigator<Policy>::progressOutput(void)
+{
+	auto progress{ getProgress() };
+	return json{
+		{ "percent", progress.percent },
+		{ "remaining", progress.remaining },
+		{ "cross_track", progress.crossTrack },
+		{ "eta",
+		  progress.eta < 0.0 ? json(nullptr) : json(progress.eta) }
+	};
+}
+
 /* Helper method to calculate bearing */
 // Compute initial bearing (degrees from North) from 'current' to
 // 'destination' Returns a value in [0,360)
 /* calculateBearing uses the “forward azimuth” formula on a spherical Earth */
-double Navigator::calculateBearing(
+template <NavigatorPolicy Policy>
+double BasicNavigator<Policy>::calculateBearing(
 	const std::pair<double, double> &current,
 	const std::pair<double, double> &destination) noexcept
 {
@@ -171,14 +568,25 @@ double Navigator::calculateBearing(
 // degrees.
 /* computeNewPosition uses the inverse great‐circle formula (based on haversine
    geometry) */
+template <NavigatorPolicy Policy>
 std::pair<double, double>
-Navigator::computeNewPosition(const std::pair<double, double> &initial,
-			      double			       timeSec) noexcept
+BasicNavigator<Policy>::computeNewPosition(
+	const std::pair<double, double> &initial, double timeSec) noexcept
 {
 	// distance travelled along great‐circle (meters) → central angle (radians)
 	double dist = simulationVelocity_ * timeSec;
 	double δ    = dist / earthRadius_;
 	double θ    = deg2rad(bearing_);
+	// in navigation frame, step in flat east-north space if both ends of the
+	// step stay within the frame's error-bounded radius
+	if (navFrame_ && !frame_.empty()) {
+		auto p{ frame_.toLocal(initial) };
+		LocalFrame::Point q{ p.first + dist * std::sin(θ),
+				     p.second + dist * std::cos(θ) };
+		if (frame_.contains(p) && frame_.contains(q)) {
+			return frame_.toGeodetic(q);
+		}
+	}
 	double φ1   = deg2rad(initial.first);
 	double λ1   = deg2rad(initial.second);
 	// compute φ2 (lat₂) and λ2 (lon₂)
@@ -197,7 +605,17 @@ Navigator::computeNewPosition(const std::pair<double, double> &initial,
 /// current      {latitude, longitude} in degrees
 /// destination  {latitude, longitude} in degrees
 /// return true if distance ≤ proximityRadius_
-bool Navigator::waypointReached(
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::waypointReached(
+	const std::pair<double, double> &current,
+	const std::pair<double, double> &destination) const noexcept
+{
+	return greatCircleDistance(current, destination) <= proximityRadius_;
+}
+
+/* Helper method to get haversine distance in meters */
+template <NavigatorPolicy Policy>
+double BasicNavigator<Policy>::greatCircleDistance(
 	const std::pair<double, double> &current,
 	const std::pair<double, double> &destination) const noexcept
 {
@@ -217,14 +635,332 @@ bool Navigator::waypointReached(
 	a = std::clamp(a, 0.0, 1.0);
 	// 3) central angle c
 	double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
-	// 4) distance and compare
-	double distance = earthRadius_ * c;
-	return distance <= proximityRadius_;
+	// 4) distance
+	return earthRadius_ * c;
+}
+
+/* Helper method to project current position into navigation frame */
+/* The frame is re-anchored on the current position whenever the system leaves
+   the frame's error-bounded radius, so long routes stay within tolerance */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::frameUpdate(void)
+{
+	if (!frame_.empty()) {
+		currLocal_ = frame_.toLocal(currPos_);
+		if (frame_.contains(currLocal_)) {
+			return;
+		}
+	}
+	frame_.anchor(currPos_);
+	frame_.project(tour_);
+	currLocal_ = { 0.0, 0.0 };
+}
+
+/* Helper method to check arrival at next destination */
+/* Uses navigation frame if enabled and destination lies within the frame's
+   error-bounded radius, else falls back to haversine */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::arrived(void)
+{
+	destDistance_ = destDistance();
+	bool reached{ destDistance_ <= proximityRadius_ };
+	/* Catch waypoints passed between ticks */
+	if (!reached && overshoot_ && hasPrev_) {
+		reached = overshot();
+	}
+	prevPos_ = currPos_;
+	hasPrev_ = true;
+	return reached;
+}
+
+/* Helper method to get distance in meters to next destination */
+/* Uses navigation frame if enabled and destination lies within the frame's
+   error-bounded radius, else falls back to haversine */
+template <NavigatorPolicy Policy>
+double BasicNavigator<Policy>::destDistance(void)
+{
+	if (navFrame_) {
+		const auto &wp{ frame_.waypoint(nextDest_) };
+		if (frame_.contains(wp)) {
+			return std::sqrt(LocalFrame::distanceSq(currLocal_, wp));
+		}
+	}
+	return greatCircleDistance(currPos_, tour_[nextDest_]);
+}
+
+/* Helper method to catch waypoints passed between ticks */
+/* Arrival is detected if the segment travelled since last tick enters the
+   proximity circle, or if it crosses the line through the destination
+   perpendicular to the leg, i.e. enters the "passed" half-plane, within a
+   lateral gate of twice the proximity radius or the segment length, whichever
+   is larger. Both tests run in a frame anchored at the destination and are
+   skipped beyond that frame's error-bounded radius */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::overshot(void)
+{
+	/* Re-anchor leg frame when destination changes */
+	if (legDest_ != nextDest_) {
+		std::size_t from{ (nextDest_ + tour_.size() - 1) %
+				  tour_.size() };
+		legFrame_.anchor(tour_[nextDest_]);
+		legFrom_ = legFrame_.toLocal(tour_[from]);
+		legDest_ = nextDest_;
+	}
+	/* Segment a→b travelled since last tick, destination at origin */
+	auto a{ legFrame_.toLocal(prevPos_) };
+	auto b{ legFrame_.toLocal(currPos_) };
+	if (!legFrame_.contains(a) || !legFrame_.contains(b)) {
+		return false;
+	}
+	double dx{ b.first - a.first };
+	double dy{ b.second - a.second };
+	double len2{ dx * dx + dy * dy };
+	double r2{ proximityRadius_ * proximityRadius_ };
+	/* Closest approach of segment to destination */
+	double t{ len2 > 0.0 ?
+			  std::clamp(-(a.first * dx + a.second * dy) / len2,
+				     0.0, 1.0) :
+			  0.0 };
+	double cx{ a.first + t * dx };
+	double cy{ a.second + t * dy };
+	if (cx * cx + cy * cy <= r2) {
+		return true;
+	}
+	/* Half-plane crossing, 'u' pointing along leg into destination */
+	double ux{ -legFrom_.first };
+	double uy{ -legFrom_.second };
+	double sa{ a.first * ux + a.second * uy };
+	double sb{ b.first * ux + b.second * uy };
+	if (sa < 0.0 && sb >= 0.0) {
+		/* Crossing point lies on the perpendicular, so its distance to
+		   the destination is its lateral offset */
+		double s{ sa / (sa - sb) };
+		double px{ a.first + s * dx };
+		double py{ a.second + s * dy };
+		double gate2{ std::max(4.0 * r2, len2) };
+		return px * px + py * py <= gate2;
+	}
+	return false;
+}
+
+/* Helper method to get bearing to next destination */
+/* Uses navigation frame if enabled and destination lies within the frame's
+   error-bounded radius, else falls back to forward azimuth */
+template <NavigatorPolicy Policy>
+double BasicNavigator<Policy>::destBearing(void)
+{
+	if (navFrame_) {
+		const auto &wp{ frame_.waypoint(nextDest_) };
+		if (frame_.contains(wp)) {
+			return LocalFrame::bearing(currLocal_, wp);
+		}
+	}
+	return calculateBearing(currPos_, dest_);
+}
+
+/* Setter for navigation frame mode */
+/* If set, per-tick bearing, distance and arrival math runs in a local
+   east-north frame projected once from the tour, with relative error bounded
+   by LocalFrame's tolerance */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setNavigationFrame(bool enable) noexcept
+{
+	navFrame_ = enable;
+}
+
+/* Setter for rate of dead-reckoned output in GPS mode */
+/* If set, getOutput() ticks at this rate on a monotonic timer, extrapolating
+   position between GPS fixes, else it ticks once per GPS fix */
+/* Cannot be set to a negative value, and is capped at 1000 Hz */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setCommandRate(double hz) noexcept
+{
+	commandRate_ = std::clamp(hz, 0.0, 1000.0);
+}
+
+/* Setter for Kalman filtering of GPS fixes */
+/* If set, fixes are fused by a constant-velocity filter and its smoothed
+   position and velocity drive navigation instead of raw fixes */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setKalmanFilter(bool enable) noexcept
+{
+	filter_ = enable;
+}
+
+/* Setter for printing output to stdout and log file */
+/* Defaults to true; in-process users such as the simulator turn it off */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setVerbose(bool enable) noexcept
+{
+	verbose_ = enable;
+}
+
+/* Load a solved tour directly, for in-process use without start() */
+/* 'waypoints' are in CSV order and 'order' is the solved visiting order
+   starting at the system's starting position. 'csvRows' gives the CSV row
+   of each waypoint if they are not in CSV order, e.g. after consolidation.
+   Returns false if the order is not a permutation of the waypoints */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::loadTour(
+	const std::vector<std::pair<double, double> > &waypoints,
+	const std::vector<std::size_t>		      &order,
+	const std::vector<std::size_t>		      &csvRows)
+{
+	if (!concorde_.setTour(waypoints, order, csvRows)) {
+		std::cerr << "Error: tour order does not match waypoints.\n";
+		return false;
+	}
+	/* Reset per-mission state */
+	nextDest_  = 1;
+	completed_ = false;
+	inMotion_  = false;
+	frame_	   = LocalFrame{};
+	kalman_.reset();
+	lastFix_.reset();
+	legs_	  = LegTable{};
+	hasPrev_  = false;
+	legDest_  = std::numeric_limits<std::size_t>::max();
+	nextTick_ = {};
+	jitter_.reset();
+	setupForNavOutput();
+	return true;
+}
+
+/* Load a tour file written by the 'mtsp' command, i.e. a waypoint CSV
+   already in visiting order from the system's starting position */
+/* Returns false if the file cannot be read */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::loadTourFile(const std::filesystem::path &file)
+{
+	ConcordeTSPSolver reader{};
+	reader.setVerbose(false);
+	reader.setCSVFile(file);
+	if (!reader.readCSV()) {
+		return false;
+	}
+	std::vector<std::size_t> order(reader.getWaypoints().size());
+	std::iota(order.begin(), order.end(), 0);
+	csvFile_ = file;
+	return loadTour(reader.getWaypoints(), order);
+}
+
+/* Getter for wake-up lateness of dead-reckoned ticks against their
+   deadlines, since the mission was loaded or last reported */
+template <NavigatorPolicy Policy>
+const JitterHistogram &BasicNavigator<Policy>::getJitter(void) const noexcept
+{
+	return jitter_;
+}
+
+/* Getter for index into tour of next destination */
+template <NavigatorPolicy Policy>
+std::size_t BasicNavigator<Policy>::getNextDest(void) const noexcept
+{
+	return nextDest_;
+}
+
+/* Getter for progress against route */
+/* Percent complete and remaining distance come from the leg table's prefix
+   sums, cross-track error from the current leg, in the navigation frame if
+   enabled and the leg lies within its error-bounded radius, and ETA from
+   current ground speed. All cost O(1) regardless of tour size */
+template <NavigatorPolicy Policy>
+RouteProgress BasicNavigator<Policy>::getProgress(void) const noexcept
+{
+	if (legs_.empty()) {
+		return { 0.0, 0.0, 0.0, -1.0 };
+	}
+	std::size_t leg{ (nextDest_ + tour_.size() - 1) % tour_.size() };
+	double	    total{ legs_.total() };
+	double	    remaining{ legs_.remaining(nextDest_, destDistance_) };
+	double	    crossTrack{};
+	const auto &a{ frame_.empty() ? currLocal_ : frame_.waypoint(leg) };
+	const auto &b{ frame_.empty() ? currLocal_ :
+					frame_.waypoint(nextDest_) };
+	double	    ux{ b.first - a.first };
+	double	    uy{ b.second - a.second };
+	double	    len{ std::hypot(ux, uy) };
+	if (navFrame_ && frame_.contains(a) && frame_.contains(b) && len > 0.0) {
+		crossTrack = ((currLocal_.first - a.first) * uy -
+			      (currLocal_.second - a.second) * ux) /
+			     len;
+	} else {
+		crossTrack = legs_.crossTrack(leg, currPos_);
+	}
+	return { total > 0.0 ?
+			 100.0 * std::clamp(1.0 - remaining / total, 0.0, 1.0) :
+			 100.0,
+		 remaining, crossTrack,
+		 groundSpeed_ > 0.0 ? remaining / groundSpeed_ : -1.0 };
+}
+
+/* Getter for tour_ */
+template <NavigatorPolicy Policy>
+const std::vector<std::pair<double, double> > &
+BasicNavigator<Policy>::getTour(void) const noexcept
+{
+	return tour_;
+}
+
+/* Getter for tourOrder_ */
+template <NavigatorPolicy Policy>
+const std::vector<std::size_t> &
+BasicNavigator<Policy>::getTourOrder(void) const noexcept
+{
+	return tourOrder_;
+}
+
+/* Getter for current command, as published to the command channel and
+   stream */
+template <NavigatorPolicy Policy>
+NavCommand BasicNavigator<Policy>::getCommand(void) const noexcept
+{
+	auto progress{ getProgress() };
+	auto now{ WallClock::now().time_since_epoch() };
+	return { static_cast<double>(bearing_),
+		 currPos_.first,
+		 currPos_.second,
+		 dest_.first,
+		 dest_.second,
+		 destDistance_,
+		 progress.crossTrack,
+		 progress.percent,
+		 waypointIndex(),
+		 std::chrono::duration_cast<std::chrono::nanoseconds>(now)
+			 .count(),
+		 completed_,
+		 static_cast<std::uint32_t>(NavStatus::ok) };
+}
+
+/* Helper method to get CSV index of next destination, 0 if no tour */
+template <NavigatorPolicy Policy>
+std::size_t BasicNavigator<Policy>::waypointIndex(void) const noexcept
+{
+	return tourOrder_.empty() ? 0 :
+				    concorde_.csvIndex(tourOrder_[nextDest_]);
+}
+
+/* Getter for gps_, e.g. to load fixes into a ReplayGPS, see replay() */
+template <NavigatorPolicy Policy>
+typename BasicNavigator<Policy>::PositionSource &
+BasicNavigator<Policy>::positionSource(void) noexcept
+{
+	return gps_;
+}
+
+/* Setter for overshoot-proof arrival detection */
+/* Defaults to true; if unset, arrival only tests the current position
+   against the proximity radius */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setOvershootDetection(bool enable) noexcept
+{
+	overshoot_ = enable;
 }
 
 /* Setter for proximity radius threshold for waypont arrival */
 /* Cannot be set to less than 1.0 */
-void Navigator::setProximityRadius(double r) noexcept
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setProximityRadius(double r) noexcept
 {
 	if (r < 1.0) {
 		proximityRadius_ = 1.0;
@@ -233,9 +969,52 @@ void Navigator::setProximityRadius(double r) noexcept
 	}
 }
 
+/* Setter for shared-memory command channel */
+/* Creates POSIX shared-memory object 'name' to which every navigation
+   output is also published as a fixed-layout NavCommand, see command.hpp.
+   Returns false if the channel could not be created */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setCommandChannel(const std::string &name)
+{
+	return channel_.open(name);
+}
+
+/* Setter for Unix domain socket command stream */
+/* Listens on socket 'path' and streams every navigation output to each
+   subscriber in 'format', see stream.hpp. Returns false if the socket could
+   not be created */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setCommandStream(const std::string &path,
+					      StreamFormat	 format)
+{
+	return stream_.open(path, format);
+}
+
+/* Setter for binary telemetry log */
+/* Appends a record per navigation output and per arrival to 'path', see
+   telemetry.hpp. Returns false if the file could not be opened */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setTelemetryFile(const std::filesystem::path &path)
+{
+	return telemetry_.open(path);
+}
+
+/* Setter for real-time profile of navigation thread */
+/* The thread calling getOutput() is pinned to 'cpu' (by default the first
+   isolated core, else the last core), scheduled SCHED_FIFO at 'priority' and
+   its memory locked, from its first tick on, see realtime.hpp. Returns false
+   if 'cpu' or 'priority' is out of range */
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setRealtimeProfile(std::optional<std::size_t> cpu,
+						int priority)
+{
+	return realtime_.configure(cpu, priority);
+}
+
 /* Setter for velocity of simulated downstream controller */
 /* Cannot be set to a negative value */
-void Navigator::setSimulationVelocity(double v) noexcept
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setSimulationVelocity(double v) noexcept
 {
 	if (v < 0.0) {
 		simulationVelocity_ = 0.0;
@@ -245,38 +1024,65 @@ void Navigator::setSimulationVelocity(double v) noexcept
 }
 
 /* Helper method to get next destination */
-std::optional<std::pair<double, double> > Navigator::getDest(void)
+template <NavigatorPolicy Policy>
+std::optional<std::pair<double, double> > BasicNavigator<Policy>::getDest(void)
 {
+	/* Project current position into navigation frame, if enabled */
+	if (navFrame_) {
+		frameUpdate();
+	}
 	/* If system has not reached the current destiation, return it */
-	if (!waypointReached(currPos_, tour_[nextDest_])) {
+	if (!arrived()) {
 		return tour_[nextDest_];
 	}
 	/* Else get next dest */
 	/* Print destination has been reached */
-	logPrint("(System Message) Waypoint reached: " +
-			 logCoordinates(tour_[nextDest_]),
-		 true);
+	if (verbose_) {
+		logPrint("(System Message) Waypoint reached: " +
+				 logCoordinates(tour_[nextDest_]),
+			 true);
+	}
+	/* Record arrival in mission state, if kept */
+	if (state_.isOpen()) {
+		state_.markVisited(nextDest_);
+	}
+	/* Record arrival in telemetry log, if kept */
+	if (telemetry_.isOpen()) {
+		recordTelemetry(TelemetryEvent::arrival, {});
+	}
 	/* If nextDest_ is 0, then tour is over and return null */
 	if (!nextDest_) {
-		logPrint("(System Message) Navigation has completed.", true);
+		if (verbose_) {
+			logPrint("(System Message) Navigation has completed.",
+				 true);
+		}
+		completed_ = true;
+		if (state_.isOpen()) {
+			state_.complete();
+		}
+		if (telemetry_.isOpen()) {
+			recordTelemetry(TelemetryEvent::complete, {});
+		}
 		return std::nullopt;
 	}
 	/* Else, return next dest */
-	nextDest_ = (nextDest_ + 1) % tour_.size();
+	nextDest_     = (nextDest_ + 1) % tour_.size();
+	destDistance_ = destDistance();
 	return tour_[nextDest_];
 }
 
 /* Helper method to get local time */
-std::tm Navigator::localTime(void)
+template <NavigatorPolicy Policy>
+std::tm BasicNavigator<Policy>::localTime(void)
 {
-	using namespace std::chrono;
-	auto	    now = system_clock::now();
-	std::time_t t	= system_clock::to_time_t(now);
+	auto	    now = WallClock::now();
+	std::time_t t	= WallClock::to_time_t(now);
 	return *std::localtime(&t); // for UTC use std::gmtime
 }
 
 /* Helper method to add timestamp to print */
-std::string Navigator::getTimestamp(void)
+template <NavigatorPolicy Policy>
+std::string BasicNavigator<Policy>::getTimestamp(void)
 {
 	auto		   tm{ localTime() };
 	std::ostringstream oss{};
@@ -284,9 +1090,14 @@ std::string Navigator::getTimestamp(void)
 	return oss.str();
 }
 
-/* Helper method to print to stdout and log file */
-void Navigator::logPrint(const std::string &message, bool timeStamp)
+/* Helper method to print to output sink and log file */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::logPrint(const std::string &message,
+				      bool		 timeStamp)
 {
+	if (!verbose_) { /* If output silenced */
+		return;
+	}
 	if (logFile_.is_open()) { /* If log enabled */
 		if (timeStamp) {
 			logFile_ << "[" << getTimestamp() << "] " << message
@@ -295,15 +1106,17 @@ void Navigator::logPrint(const std::string &message, bool timeStamp)
 			logFile_ << message << "\n";
 		}
 	}
+	std::string line{};
 	if (timeStamp) {
-		std::cout << "[" << getTimestamp() << "] " << message << "\n";
-	} else {
-		std::cout << message << "\n";
+		line.append("[").append(getTimestamp()).append("] ");
 	}
+	sink_.write(line.append(message).append("\n"));
 }
 
 /* Helper method to log coordinates */
-std::string Navigator::logCoordinates(const std::pair<double, double> &c)
+template <NavigatorPolicy Policy>
+std::string
+BasicNavigator<Policy>::logCoordinates(const std::pair<double, double> &c)
 {
 	std::ostringstream oss;
 	oss << std::fixed << std::setprecision(4) << "[Latitude: " << c.first
@@ -311,17 +1124,20 @@ std::string Navigator::logCoordinates(const std::pair<double, double> &c)
 	return oss.str();
 }
 
-/* Log waypoint method to print waypoints to stdout */
-void Navigator::logFix(const GPSFix &fix) noexcept
+/* Log waypoint method to print waypoints to output sink */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::logFix(const GPSFix &fix) noexcept
 {
-	std::cout << std::fixed << std::setprecision(4)
-		  << "[Latitude: " << fix.latitude
-		  << ", Longitude: " << fix.longitude
-		  << ", Bearing: " << fix.heading << "]\n";
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(4) << "[Latitude: " << fix.latitude
+	    << ", Longitude: " << fix.longitude << ", Bearing: " << fix.heading
+	    << "]\n";
+	sink_.write(oss.str());
 }
 
 /* Helper method to test GPS connection in hot loop */
-bool Navigator::testGPSConnection(void)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::testGPSConnection(void)
 {
 	std::cout << "Testing GPS connection.\n";
 	if (!gps_.connect()) {
@@ -333,7 +1149,7 @@ bool Navigator::testGPSConnection(void)
 	for (size_t i = 0; i < tries; i++) {
 		auto optFix{ gps_.waitReadFix() };
 		std::cout << "(" << i + 1 << "/" << tries << ") ";
-		logFix(optFix ? *optFix : GPSFix{ 0, 0, 0 });
+		logFix(optFix ? *optFix : GPSFix{ 0, 0, 0, 0, 0, 0, 0 });
 		/* Check that last poll gives a fix */
 		if (i == tries - 1 && optFix) {
 			std::cout << "GPS connection successful.\n\n";
@@ -344,13 +1160,12 @@ bool Navigator::testGPSConnection(void)
 }
 
 /* Helper method to use ConcordeTSPSolver to parse CSV */
-bool Navigator::readCSV(void)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::readCSV(void)
 {
-	std::cout << "Enter waypoint CSV path: ";
-	std::filesystem::path path{};
-	std::cin >> path;
 	/* Set CSV path */
-	std::filesystem::path csvFile{ expandTilde(path) };
+	std::filesystem::path csvFile{ readPath("Enter waypoint CSV path: ",
+						options_.csv) };
 	concorde_.setCSVFile(csvFile);
 	/* Read in waypoints from CSV */
 	if (concorde_.readCSV()) {
@@ -365,10 +1180,23 @@ bool Navigator::readCSV(void)
 }
 
 /* Hot loop to run navigation system */
-void Navigator::run(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::run(void)
 {
 	/* Test GPS connection */
 	gpspoll(false);
+	/* Start from compiled mission, if given, without reading CSV or
+	   solving */
+	if (options_.bundle) {
+		loadBundle(expandTilde(*options_.bundle));
+		setLogDir();
+		setupForNavOutput();
+		keepMissionState();
+		std::cout << "\033[1;32m"
+			  << "Mission bundle loaded. Ready to provide navigation output.\n\n"
+			  << "\033[0m";
+		return;
+	}
 	/* Enter waypoint CSV path */
 	while (true) {
 		/* If read was successful proceed */
@@ -376,7 +1204,7 @@ void Navigator::run(void)
 			break;
 		}
 		/* If reading CSV failed, prompt user to retry */
-		retryPrompt("Reading CSV failed.");
+		retry("Reading CSV failed.", options_.csv.has_value());
 	}
 	/* Set directories for Concorde */
 	setDirectories(false, true);
@@ -384,6 +1212,8 @@ void Navigator::run(void)
 	concordeTSP();
 	/* Setup for navigation output */
 	setupForNavOutput();
+	/* Keep mission state for 'resume' */
+	keepMissionState();
 	/* Print ready output */
 	std::cout
 		<< "\033[1;32m"
@@ -391,11 +1221,138 @@ void Navigator::run(void)
 		<< "\033[0m";
 }
 
+/* Helper method to load tour, leg table and navigation frame from mission
+   bundle 'path', see MissionBundle */
+/* Exits if the bundle is missing or invalid */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::loadBundle(const std::filesystem::path &path)
+{
+	auto	      start{ std::chrono::steady_clock::now() };
+	MissionBundle bundle{};
+	if (!bundle.open(path)) {
+		std::cerr << "Error: " << path
+			  << " is missing or not a valid mission bundle.\n";
+		quit(1);
+	}
+	if (!concorde_.setTour(bundle.waypoints(), bundle.order(),
+			       bundle.csvRows())) {
+		std::cerr << "Error: Mission bundle is corrupt.\n";
+		quit(1);
+	}
+	csvFile_ = bundle.csvFile();
+	legs_.load(bundle.legs(), bundle.cumulative());
+	frame_.anchor(bundle.anchor());
+	frame_.load(bundle.projected());
+	auto end{ std::chrono::steady_clock::now() };
+	std::cout << "Loaded " << tour_.size() << " waypoint, "
+		  << bundle.length() << " m mission from " << path << " in "
+		  << std::chrono::duration_cast<std::chrono::microseconds>(
+			     end - start)
+		  << ".\n";
+}
+
+/* Helper method to keep state of loaded mission for 'resume' */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::keepMissionState(void)
+{
+	auto statePath{ options_.state ? expandTilde(*options_.state) :
+				 MissionState::defaultPath() };
+	if (state_.create(statePath, concorde_.getWaypoints(), tourOrder_,
+			  concorde_.csvRows(), csvFile_, logDir_)) {
+		std::cout << "Mission state kept in " << statePath << ".\n";
+	}
+}
+
+/* Resume interrupted mission from its state file */
+/* Maps the state kept by 'run', restores tour, next destination and last
+   position without prompts or re-solving, and continues navigating */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::resume(void)
+{
+	auto start{ std::chrono::steady_clock::now() };
+	auto statePath{ options_.state ? expandTilde(*options_.state) :
+				 MissionState::defaultPath() };
+	if (!state_.open(statePath)) {
+		std::cerr << "Error: No mission state to resume in " << statePath
+			  << ".\n";
+		quit(1);
+	}
+	if (state_.completed()) {
+		std::cerr << "Error: Mission has already completed.\n";
+		quit(1);
+	}
+	if (!concorde_.setTour(state_.waypoints(), state_.order(),
+			       state_.csvRows())) {
+		std::cerr << "Error: Mission state is corrupt.\n";
+		quit(1);
+	}
+	/* Restore paths, appending to existing log */
+	csvFile_ = state_.csvFile();
+	setupForNavOutput();
+	logDir_ = state_.logDir();
+	if (!logDir_.empty()) {
+		logFile_.open(logDir_ / (csvFile_.stem().string() + ".log"),
+			      std::ios::app);
+	}
+	/* Restore progress */
+	nextDest_     = state_.nextDest();
+	currPos_      = state_.position();
+	inMotion_     = true;
+	destDistance_ = destDistance();
+	auto end{ std::chrono::steady_clock::now() };
+	std::cout << "Restored mission at waypoint " << nextDest_ << "/"
+		  << tour_.size() - 1 << " in "
+		  << std::chrono::duration_cast<std::chrono::microseconds>(
+			     end - start)
+		  << ".\n";
+	/* Reconnect to GPS without test polls, waiting for gpsd if it is still
+	   starting up */
+	while (!gps_.connect()) {
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+	}
+	gps_.startStream();
+	std::cout << "\033[1;32m"
+		  << "Mission resumed. Ready to provide navigation output.\n\n"
+		  << "\033[0m";
+}
+
+/* Offline simulation of navigation system */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::simulate(void)
+{
+	/* Enter waypoint CSV path */
+	while (true) {
+		/* If read was successful proceed */
+		if (readCSV()) {
+			break;
+		}
+		/* If reading CSV failed, prompt user to retry */
+		retry("Reading CSV failed.", options_.csv.has_value());
+	}
+	/* Set directories for Concorde */
+	setDirectories(false, true);
+	/* Read and generate solution from TSP file */
+	concordeTSP();
+	/* Setup for navigation output */
+	setupForNavOutput();
+	offline_ = true;
+	/* Print ready output */
+	std::cout
+		<< "\033[1;32m"
+		<< "Optimal tour has been calculated. Ready to simulate mission.\n\n"
+		<< "\033[0m";
+}
+
 /* Helper method to setup for navigation output */
-void Navigator::setupForNavOutput(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setupForNavOutput(void)
 {
 	/* Set current position of system */
 	currPos_ = tour_.at(0);
+	/* Build leg table for route progress, unless loaded from a bundle */
+	if (legs_.empty()) {
+		legs_.build(tour_);
+	}
 	/* Navigator is ready */
 	ready_ = true;
 	/* Create and open log file, if logging */
@@ -411,14 +1368,16 @@ void Navigator::setupForNavOutput(void)
 }
 
 /* Destructor */
-Navigator::~Navigator(void)
+template <NavigatorPolicy Policy>
+BasicNavigator<Policy>::~BasicNavigator(void)
 {
 	/* Call stop() to properly close open resources */
 	stop();
 }
 
 /* Stop GPS stream connection */
-void Navigator::stop(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::stop(void)
 {
 	/* Stop GPS stream */
 	gps_.stopStream();
@@ -428,8 +1387,20 @@ void Navigator::stop(void)
 	}
 }
 
+/* Close the command channel and stream, which would otherwise be left in
+   /dev/shm and the filesystem, flush telemetry and exit with 'status' */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::quit(int status) noexcept
+{
+	channel_.close();
+	stream_.close();
+	telemetry_.close();
+	std::exit(status);
+}
+
 /* Print helper asking user to retry an action */
-void Navigator::retryPrompt(const char *message) noexcept
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::retryPrompt(const char *message) noexcept
 {
 	std::cout << message << " Press Enter to retry.";
 	std::cout.flush();
@@ -440,8 +1411,120 @@ void Navigator::retryPrompt(const char *message) noexcept
 	std::cout << "\n";
 }
 
+/* Helper method to apply options given for API setters */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::applyOptions(void)
+{
+	if (options_.radius) {
+		setProximityRadius(*options_.radius);
+	}
+	if (options_.velocity) {
+		setSimulationVelocity(*options_.velocity);
+	}
+	if (options_.rate) {
+		setCommandRate(*options_.rate);
+	}
+	if (options_.frame) {
+		setNavigationFrame(*options_.frame);
+	}
+	if (options_.filter) {
+		setKalmanFilter(*options_.filter);
+	}
+	if (options_.overshoot) {
+		setOvershootDetection(*options_.overshoot);
+	}
+	if (options_.verbose) {
+		setVerbose(*options_.verbose);
+	}
+	if (options_.solver) {
+		concorde_.setSolver(*options_.solver);
+	}
+	if (options_.consolidate) {
+		concorde_.setConsolidationRadius(*options_.consolidate);
+	}
+	if (options_.clusters) {
+		concorde_.setClusters(options_.clusters);
+	}
+	if (options_.turnPenalty) {
+		concorde_.setTurnPenalty(*options_.turnPenalty);
+	}
+	if (options_.elevation) {
+		auto grid{ std::make_shared<ElevationGrid>() };
+		if (!grid->load(*options_.elevation)) {
+			std::cerr << "Error: cannot read elevation grid "
+				  << *options_.elevation << ".\n";
+			quit(1);
+		}
+		concorde_.setElevationGrid(std::move(grid));
+	}
+	if (options_.solveTimeout) {
+		concorde_.setTimeout(
+			std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::duration<double>(
+					std::max(*options_.solveTimeout, 0.0))));
+	}
+	/* Only commands that navigate publish commands, so others leave no
+	   channel or socket behind */
+	std::string_view command{ argv_[1] };
+	bool		 navigating{ command == "run" || command == "resume" ||
+			     command == "serve" };
+	if (navigating && options_.channel &&
+	    !setCommandChannel(*options_.channel)) {
+		quit(1);
+	}
+	if (navigating && options_.stream &&
+	    !setCommandStream(*options_.stream,
+			      options_.streamFormat.value_or(
+				      StreamFormat::binary))) {
+		quit(1);
+	}
+	if (options_.realtime.value_or(false) &&
+	    !setRealtimeProfile(
+		    options_.rtCpu,
+		    options_.rtPriority ?
+			    static_cast<int>(std::min<std::size_t>(
+				    *options_.rtPriority, 1000)) :
+			    RealtimeProfile::defaultPriority)) {
+		quit(1);
+	}
+	/* 'analyze' and 'replay' read the telemetry file instead of appending
+	   to it */
+	if (options_.telemetry && command != "analyze" && command != "replay" &&
+	    !setTelemetryFile(expandTilde(*options_.telemetry))) {
+		quit(1);
+	}
+}
+
+/* Helper to retry an action, exiting instead if its input was given in
+   options since asking again cannot fix it */
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::retry(const char *message, bool given)
+{
+	if (given) {
+		std::cerr << "Error: " << message << "\n";
+		quit(1);
+	}
+	retryPrompt(message);
+}
+
+/* Helper method to take path from options if 'given', else prompt for it */
+template <NavigatorPolicy Policy>
+std::filesystem::path
+BasicNavigator<Policy>::readPath(const char				 *prompt,
+				 const std::optional<std::filesystem::path> &given)
+{
+	if (given) {
+		return expandTilde(*given);
+	}
+	std::cout << prompt;
+	std::filesystem::path path{};
+	std::cin >> path;
+	return expandTilde(path);
+}
+
 /* Constructor */
-Navigator::Navigator(int argc, const char **argv) noexcept
+template <NavigatorPolicy Policy>
+BasicNavigator<Policy>::BasicNavigator(int argc, const char **argv) noexcept
 	: prog_{ *argv },
 	  argc_{ argc },
 	  argv_{ argv },
@@ -451,12 +1534,39 @@ Navigator::Navigator(int argc, const char **argv) noexcept
 	  nextDest_{ 1 },
 	  inMotion_{ false },
 	  proximityRadius_{ 0 },
-	  simulationVelocity_{ 0 }
+	  simulationVelocity_{ 0 },
+	  navFrame_{ false },
+	  currLocal_{ 0.0, 0.0 },
+	  commandRate_{ 0 },
+	  drVelocity_{ 0.0, 0.0 },
+	  filter_{ false },
+	  kfTime_{ 0.0 },
+	  overshoot_{ true },
+	  hasPrev_{ false },
+	  prevPos_{ 0.0, 0.0 },
+	  legDest_{ std::numeric_limits<std::size_t>::max() },
+	  legFrom_{ 0.0, 0.0 },
+	  destDistance_{ 0.0 },
+	  groundSpeed_{ -1.0 },
+	  verbose_{ true },
+	  offline_{ false },
+	  reported_{ false },
+	  completed_{ false },
+	  interrupted_{ false },
+	  serving_{ false }
+{
+}
+
+/* Constructor for in-process use without a CLI, see loadTour() */
+template <NavigatorPolicy Policy>
+BasicNavigator<Policy>::BasicNavigator(void) noexcept
+	: BasicNavigator{ 1, defaultArgv_ }
 {
 }
 
 /* GPS poll, if exit is true then exit program */
-void Navigator::gpspoll(bool exit)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::gpspoll(bool exit)
 {
 	/* Test GPS connection */
 	while (true) {
@@ -464,37 +1574,79 @@ void Navigator::gpspoll(bool exit)
 		if (testGPSConnection()) {
 			break;
 		}
-		/* Else, ask user whether to retry connection */
-		retryPrompt("GPS connection failed.");
+		/* Else, ask user whether to retry connection, or retry after a
+		   second if running unattended */
+		if (isatty(STDIN_FILENO)) {
+			retryPrompt("GPS connection failed.");
+		} else {
+			std::this_thread::sleep_for(std::chrono::seconds(1));
+		}
 	}
 	if (exit) {
-		std::exit(0);
+		quit(0);
 	}
 }
 
 /* Starting point of Navigator that parses user args */
-void Navigator::start(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::start(void)
 {
-	/* If incorrect number of args passed, default to help */
-	if (argc_ != 2) {
+	/* If no command passed, default to help */
+	if (argc_ < 2) {
 		help();
-	} else {
-		std::string argStr{ argv_[1] };
-		if (argStr == "gpspoll") { /* Go to gpspoll */
-			gpspoll(true);
-		} else if (argStr == "run") { /* Go to run */
-			run();
-		} else if (argStr == "solve") { /* Go to solve  */
-			solve();
-		} else { /* Any other string is invalid so default to help */
-			help();
+	}
+	/* Parse options following command, then config file if given */
+	try {
+		NavOptions flags{};
+		flags.parse(argc_ - 2, argv_ + 2);
+		if (flags.config) {
+			NavOptions file{};
+			file.load(expandTilde(*flags.config));
+			flags.merge(file);
 		}
+		options_ = std::move(flags);
+	} catch (const std::invalid_argument &e) {
+		std::cerr << "Error: " << e.what() << ". See '" << prog_
+			  << " help'.\n";
+		quit(1);
+	}
+	applyOptions();
+	/* Dispatch command */
+	std::string argStr{ argv_[1] };
+	if (argStr == "gpspoll") { /* Go to gpspoll */
+		gpspoll(true);
+	} else if (argStr == "run") { /* Go to run */
+		run();
+	} else if (argStr == "resume") { /* Go to resume */
+		resume();
+	} else if (argStr == "simulate") { /* Go to simulate */
+		simulate();
+	} else if (argStr == "batch") { /* Go to batch */
+		batch();
+	} else if (argStr == "mtsp") { /* Go to mtsp */
+		mtsp();
+	} else if (argStr == "serve") { /* Go to serve */
+		serve();
+	} else if (argStr == "solve") { /* Go to solve  */
+		solve();
+	} else if (argStr == "compile") { /* Go to compile */
+		compile();
+	} else if (argStr == "analyze") { /* Go to analyze */
+		analyze();
+	} else if (argStr == "replay") { /* Go to replay */
+		replay();
+	} else if (argStr == "bench-solve") { /* Go to benchSolve */
+		benchSolve();
+	} else { /* Any other string is invalid so default to help */
+		help();
 	}
 }
 
 /* Helper function helping to expand tilde if user opts to use it in CSV path
    string */
-std::filesystem::path Navigator::expandTilde(const std::filesystem::path &p)
+template <NavigatorPolicy Policy>
+std::filesystem::path
+BasicNavigator<Policy>::expandTilde(const std::filesystem::path &p)
 {
 	std::string s = p.string();
 	if (!s.empty() && s[0] == '~') {
@@ -509,12 +1661,11 @@ std::filesystem::path Navigator::expandTilde(const std::filesystem::path &p)
 }
 
 /* Helper method to set TSP directory for Concorde*/
-bool Navigator::setCSVDir(void)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setCSVDir(void)
 {
-	std::cout << "Enter CSV waypoint directory: ";
-	std::filesystem::path csvDir{};
-	std::cin >> csvDir;
-	csvDir = expandTilde(csvDir);
+	std::filesystem::path csvDir{ readPath("Enter CSV waypoint directory: ",
+					       options_.csvDir) };
 	/* Check for valid directory path */
 	if (checkValidDir(csvDir)) {
 		concorde_.setCSVDir(csvDir);
@@ -525,12 +1676,11 @@ bool Navigator::setCSVDir(void)
 }
 
 /* Helper method to set TSP directory for Concorde*/
-bool Navigator::setTSPDir(void)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setTSPDir(void)
 {
-	std::cout << "Enter TSP directory: ";
-	std::filesystem::path tspDir{};
-	std::cin >> tspDir;
-	tspDir = expandTilde(tspDir);
+	std::filesystem::path tspDir{ readPath("Enter TSP directory: ",
+					       options_.tspDir) };
 	if (checkValidDir(tspDir)) {
 		concorde_.setTSPDir((tspDir));
 		printPath(tspDir);
@@ -540,12 +1690,11 @@ bool Navigator::setTSPDir(void)
 }
 
 /* Helper method to set solution directory for Concorde*/
-bool Navigator::setSolDir(void)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setSolDir(void)
 {
-	std::cout << "Enter solution directory: ";
-	std::filesystem::path solDir{};
-	std::cin >> solDir;
-	solDir = expandTilde(solDir);
+	std::filesystem::path solDir{ readPath("Enter solution directory: ",
+					       options_.solDir) };
 	if (checkValidDir(solDir)) {
 		concorde_.setSolDir(solDir);
 		printPath(solDir);
@@ -555,11 +1704,10 @@ bool Navigator::setSolDir(void)
 }
 
 /* Helper for setLogDir */
-bool Navigator::setLogDirHelper(void)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setLogDirHelper(void)
 {
-	std::cout << "Enter log directory: ";
-	std::cin >> logDir_;
-	logDir_ = expandTilde(logDir_);
+	logDir_ = readPath("Enter log directory: ", options_.logDir);
 	if (checkValidDir(logDir_)) {
 		printPath(logDir_);
 		return true;
@@ -568,8 +1716,22 @@ bool Navigator::setLogDirHelper(void)
 }
 
 /* Helper method to set log directory for Navigator */
-void Navigator::setLogDir(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setLogDir(void)
 {
+	/* Skip question if logging was given in options */
+	if (options_.log == false) {
+		return;
+	}
+	if (options_.logDir) {
+		while (true) {
+			if (setLogDirHelper()) {
+				break;
+			}
+			retry("Log directory not valid.", true);
+		}
+		return;
+	}
 	while (true) {
 		std::cout << "Log controller output to file? [y/n]: ";
 		std::string res{};
@@ -580,7 +1742,8 @@ void Navigator::setLogDir(void)
 				if (setLogDirHelper()) {
 					break;
 				}
-				retryPrompt("Log directory not valid.");
+				retry("Log directory not valid.",
+				      options_.logDir.has_value());
 			}
 			break;
 		} else if (r == 'n') {
@@ -591,12 +1754,11 @@ void Navigator::setLogDir(void)
 }
 
 /* Helper method to set graph directory for Concorde*/
-bool Navigator::setGraphDir(void)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::setGraphDir(void)
 {
-	std::cout << "Enter graph directory: ";
-	std::filesystem::path graphDir{};
-	std::cin >> graphDir;
-	graphDir = expandTilde(graphDir);
+	std::filesystem::path graphDir{ readPath("Enter graph directory: ",
+						 options_.graphDir) };
 	if (checkValidDir(graphDir)) {
 		concorde_.setGraphDir(graphDir);
 		printPath(graphDir);
@@ -606,13 +1768,15 @@ bool Navigator::setGraphDir(void)
 }
 
 /* Print path helper method */
-void Navigator::printPath(const std::filesystem::path &p)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::printPath(const std::filesystem::path &p)
 {
 	std::cout << std::filesystem::absolute(p) << " found.\n\n";
 }
 
 /* Helper method to check CSV directory */
-bool Navigator::checkValidDir(const std::filesystem::path &p)
+template <NavigatorPolicy Policy>
+bool BasicNavigator<Policy>::checkValidDir(const std::filesystem::path &p)
 {
 	/* Check for valid directory path */
 	if (std::filesystem::exists(p) && std::filesystem::is_directory(p)) {
@@ -622,7 +1786,8 @@ bool Navigator::checkValidDir(const std::filesystem::path &p)
 }
 
 /* Helper method to invoke and time Concorde solving TSP */
-void Navigator::solveTSPMeasureTime(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::solveTSPMeasureTime(void)
 {
 	/* Measure time it takes to solve TSP file */
 	auto start{ std::chrono::steady_clock::now() };
@@ -635,7 +1800,8 @@ void Navigator::solveTSPMeasureTime(void)
 }
 
 /* Helper method to read and generate solution from CSV file */
-void Navigator::concordeTSP(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::concordeTSP(void)
 {
 	/* Write TSP file */
 	concorde_.writeTSPFile();
@@ -648,7 +1814,8 @@ void Navigator::concordeTSP(void)
 }
 
 /* Helper method to generate solutions from CSV directory */
-void Navigator::makeSolutions(void)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::makeSolutions(void)
 {
 	/* Iterate through every CSV file in CSV directory */
 	std::size_t solCtr{ 0 };
@@ -689,7 +1856,8 @@ void Navigator::makeSolutions(void)
 /* First param pass true if asking for CSV directory, false otherwise */
 /* Second param pass tue if navigator should log controller output, false
    otherwise */
-void Navigator::setDirectories(bool csvDir, bool logDir)
+template <NavigatorPolicy Policy>
+void BasicNavigator<Policy>::setDirectories(bool csvDir, bool logDir)
 {
 	if (csvDir) {
 		/* Set valid CSV directory */
@@ -697,7 +1865,8 @@ void Navigator::setDirectories(bool csvDir, bool logDir)
 			if (setCSVDir()) {
 				break;
 			}
-			retryPrompt("CSV directory not valid.");
+			retry("CSV directory not valid.",
+			      options_.csvDir.has_value());
 		}
 	}
 	/* Set TSP directory */
@@ -705,21 +1874,23 @@ void Navigator::setDirectories(bool csvDir, bool logDir)
 		if (setTSPDir()) {
 			break;
 		}
-		retryPrompt("TSV directory not valid.");
+		retry("TSV directory not valid.", options_.tspDir.has_value());
 	}
 	/* Set solution directory */
 	while (true) {
 		if (setSolDir()) {
 			break;
 		}
-		retryPrompt("Solution directory not valid.");
+		retry("Solution directory not valid.",
+		      options_.solDir.has_value());
 	}
 	/* Set graph directory */
 	while (true) {
 		if (setGraphDir()) {
 			break;
 		}
-		retryPrompt("Graph directory not valid.");
+		retry("Graph directory not valid.",
+		      options_.graphDir.has_value());
 	}
 	/* Optional: set log directory */
 	if (logDir) {
@@ -728,28 +1899,820 @@ void Navigator::setDirectories(bool csvDir, bool logDir)
 }
 
 /* CLI mode to solve directory of waypoints */
-[[noreturn]] void Navigator::solve(void)
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::solve(void)
 {
 	/* Set directories for Concorde */
 	setDirectories(true, false);
+	/* Keep solving CSV files as they change, if asked */
+	if (options_.watch.value_or(false)) {
+		watchSolutions();
+	}
 	/* Make solutions from CSV files */
 	makeSolutions();
-	std::exit(0);
+	quit(0);
+}
+
+/* Helper method to solve CSV files in CSV directory as they are created or
+   changed, until the directory goes away */
+/* Files whose solution is missing or older are solved first. Each is solved
+   and plotted by its own copy of the configured solver on a worker pool */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::watchSolutions(void)
+{
+	using namespace std::chrono;
+	const auto	&csvDir{ concorde_.getCSVDir() };
+	DirectoryWatcher watcher{ milliseconds(250) };
+	if (!watcher.watch(csvDir, ".csv")) {
+		std::cerr << "Error: cannot watch " << csvDir << ".\n";
+		quit(1);
+	}
+	/* Solve each file with a copy of the configured solver. Lines are
+	   flushed as printed, since this mode only ends when killed */
+	std::mutex printMutex{};
+	auto	   job{ [&](const std::filesystem::path &file) {
+		  Solver solver{ concorde_ };
+		  solver.setVerbose(false);
+		  solver.setCSVFile(file);
+		  auto start{ steady_clock::now() };
+		  bool solved{ solver.readCSV() };
+		  if (solved) {
+			  solver.writeTSPFile();
+			  solver.solveTSP();
+			  solver.readTSPSolution();
+			  solver.plotTSPSolution();
+			  solved = solver.getTourOrder().size() ==
+				   solver.getWaypoints().size();
+		  }
+		  auto		  end{ steady_clock::now() };
+		  std::lock_guard lock{ printMutex };
+		  if (!solved) {
+			  std::cerr << "Error: cannot solve " << file << ".\n";
+			  return;
+		  }
+		  std::cout << "Solved " << file.filename() << ": "
+			    << solver.getWaypoints().size() << " waypoints in "
+			    << duration_cast<microseconds>(end - start) << "."
+			    << std::endl;
+	  } };
+	/* Pool is scoped so running jobs finish before exiting */
+	{
+		FilePool pool{ job, 0 };
+		/* Catch up on files changed since they were last solved */
+		std::error_code ec{};
+		for (const auto &entry :
+		     std::filesystem::directory_iterator(csvDir, ec)) {
+			auto path{ entry.path() };
+			if (!entry.is_regular_file() ||
+			    path.extension() != ".csv") {
+				continue;
+			}
+			auto sol{ concorde_.getSolDir() /
+				  (path.stem().string() + ".sol") };
+			if (!std::filesystem::exists(sol) ||
+			    std::filesystem::last_write_time(sol, ec) <
+				    entry.last_write_time(ec)) {
+				pool.submit(path);
+			}
+		}
+		{
+			std::lock_guard lock{ printMutex };
+			std::cout << "\033[1;32m" << "Watching " << csvDir
+				  << " for changed CSV files.\n"
+				  << "\033[0m" << std::flush;
+		}
+		for (auto files{ watcher.wait() }; !files.empty();
+		     files = watcher.wait()) {
+			for (const auto &file : files) {
+				pool.submit(file);
+			}
+		}
+	}
+	std::cerr << "Error: " << csvDir << " is no longer watchable.\n";
+	quit(1);
+}
+
+/* CLI mode to compile a mission into a bundle for 'run --bundle' */
+/* Solves the CSV and writes the solved tour with its projected waypoints and
+   leg table to the bundle path, else '<stem>.awmb' in the solution
+   directory */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::compile(void)
+{
+	/* Enter waypoint CSV path */
+	while (true) {
+		if (readCSV()) {
+			break;
+		}
+		retry("Reading CSV failed.", options_.csv.has_value());
+	}
+	/* Set directories for Concorde and solve */
+	setDirectories(false, false);
+	concordeTSP();
+	auto path{ options_.bundle ?
+			   expandTilde(*options_.bundle) :
+			   concorde_.getSolDir() /
+				   (csvFile_.stem().string() + ".awmb") };
+	if (!MissionBundle::write(path, csvFile_, concorde_.getWaypoints(),
+				  tourOrder_, concorde_.csvRows())) {
+		quit(1);
+	}
+	std::cout << "\033[1;32m"
+		  << "Compiled mission bundle: " << path << "\n"
+		  << "\033[0m";
+	quit(0);
+}
+
+/* Helper method to split comma-separated option into its non-empty items */
+static std::vector<std::string> splitList(const std::string &list)
+{
+	std::vector<std::string> items{};
+	std::istringstream	 in{ list };
+	for (std::string item; std::getline(in, item, ',');) {
+		if (!item.empty()) {
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+/* CLI mode to evaluate navigation parameters over directory of waypoints */
+/* Solves every CSV, then simulates each mission across the BatchEvaluator's
+   parameter grid on all cores and writes a summary table to stdout and, if
+   logging, to 'batch.csv' in the log directory */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::batch(void)
+{
+	BatchEvaluator evaluator{};
+	/* Set grid axes given as lists, else narrowed to a single value given,
+	   else left at the evaluator's defaults */
+	auto axis{ [&](const std::optional<std::string> &list,
+		       const std::optional<double> &value, const char *name) {
+		std::vector<double> values{};
+		if (!list) {
+			if (value) {
+				values.push_back(*value);
+			}
+			return values;
+		}
+		for (const auto &item : splitList(*list)) {
+			std::size_t pos{ 0 };
+			double	    number{ 0.0 };
+			try {
+				number = std::stod(item, &pos);
+			} catch (const std::exception &) {
+			}
+			if (pos != item.size() || !std::isfinite(number) ||
+			    number <= 0.0) {
+				std::cerr << "Error: invalid " << name << " '"
+					  << item << "'.\n";
+				quit(1);
+			}
+			values.push_back(number);
+		}
+		return values;
+	} };
+	evaluator.setVelocities(
+		axis(options_.velocities, options_.velocity, "velocity"));
+	evaluator.setRadii(axis(options_.radii, options_.radius, "radius"));
+	evaluator.setTicks(axis(options_.ticks, std::nullopt, "tick"));
+	if (options_.noise) {
+		std::vector<NoiseModel> models{};
+		for (const auto &item : splitList(*options_.noise)) {
+			auto model{ BatchEvaluator::noiseModel(item) };
+			if (!model) {
+				std::cerr << "Error: unknown noise model '"
+					  << item << "'.\n";
+				quit(1);
+			}
+			models.push_back(std::move(*model));
+		}
+		evaluator.setNoiseModels(std::move(models));
+	}
+	if (options_.trials) {
+		evaluator.setTrials(*options_.trials);
+	}
+	/* Set directories for Concorde and summary output */
+	setDirectories(true, true);
+	/* Solve every CSV file in CSV directory */
+	for (auto const &entry :
+	     std::filesystem::directory_iterator(concorde_.getCSVDir())) {
+		auto path = entry.path();
+		/* If not regular CSV file, skip */
+		if (!entry.is_regular_file() || path.extension() != ".csv")
+			continue;
+		concorde_.setCSVFile(path);
+		if (!concorde_.readCSV()) {
+			continue;
+		}
+		concordeTSP();
+		/* If solution does not cover waypoints, skip */
+		if (concorde_.getTourOrder().size() !=
+		    concorde_.getWaypoints().size()) {
+			continue;
+		}
+		evaluator.addMission(path.stem().string(),
+				     concorde_.getWaypoints(),
+				     concorde_.getTourOrder());
+		std::cout << "\n";
+	}
+	if (!evaluator.jobCount()) {
+		std::cerr << "Error: No missions were able to be solved.\n";
+		quit(1);
+	}
+	/* Run simulations and time them */
+	std::cout << "Running " << evaluator.jobCount() << " simulations.\n";
+	auto start{ std::chrono::steady_clock::now() };
+	auto rows{ evaluator.run(0) };
+	auto end{ std::chrono::steady_clock::now() };
+	BatchEvaluator::writeSummary(std::cout, rows);
+	std::cout << "Simulated in "
+		  << std::chrono::duration_cast<std::chrono::milliseconds>(
+			     end - start)
+		  << ".\n";
+	/* Write summary to log directory, if logging */
+	if (!logDir_.empty()) {
+		std::filesystem::path summary{ logDir_ / "batch.csv" };
+		std::ofstream	      out{ summary };
+		BatchEvaluator::writeSummary(out, rows);
+		std::cout << "Wrote summary: " << summary << ".\n";
+	}
+	quit(0);
+}
+
+/* CLI mode to serve missions over a Unix domain socket with warm state */
+/* Connects to GPS and sets directories once, then takes requests as JSON
+   lines, see serveRequest(), navigating the current mission between
+   requests. Each distinct waypoint set is solved once and repeats load from
+   the route cache */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::serve(void)
+{
+	/* Test GPS connection once, keeping stream open */
+	gpspoll(false);
+	/* Set directories for Concorde once */
+	setDirectories(false, true);
+	std::filesystem::path socket{ options_.socket ?
+					      expandTilde(*options_.socket) :
+					      "/tmp/awns-rpi5-serve.sock" };
+	MissionServer server{};
+	if (!server.open(socket)) {
+		quit(1);
+	}
+	std::cout << "\033[1;32m" << "Serving missions on " << socket << ".\n\n"
+		  << "\033[0m";
+	/* Waits for fixes return early when a request arrives */
+	gps_.setWakeFd(server.fd());
+	while (true) {
+		/* Block for requests while idle, only check while navigating */
+		for (auto &request : server.poll(serving_ ? 0 : -1)) {
+			server.reply(request.client, serveRequest(request.body));
+			if (request.body.is_object() &&
+			    request.body.value("command", "") == "shutdown") {
+				server.close();
+				quit(0);
+			}
+		}
+		if (serving_ && !getOutput() && !interrupted_) {
+			serving_ = false;
+			logPrint("(System Message) Mission ended. Waiting for next mission.",
+				 true);
+		}
+	}
+}
+
+/* Helper method to answer one 'serve' request */
+/* Requests are {"command": "load", "csv": PATH} or {"command": "load",
+   "waypoints": [[LAT, LON], ...], "name": NAME} to solve, or load from the
+   route cache, and start navigating a mission, {"command": "status"},
+   {"command": "stop"} to stop navigating and {"command": "shutdown"} */
+template <NavigatorPolicy Policy>
+json BasicNavigator<Policy>::serveRequest(const json &request)
+{
+	auto error{ [](const std::string &message) {
+		return json{ { "ok", false }, { "error", message } };
+	} };
+	if (!request.is_object()) {
+		return error("malformed request");
+	}
+	std::string command{ request.value("command", "") };
+	if (command == "status") {
+		return { { "ok", true },
+			 { "navigating", serving_ },
+			 { "mission", csvFile_.stem().string() },
+			 { "waypoint", nextDest_ },
+			 { "progress", progressOutput() } };
+	} else if (command == "stop") {
+		serving_ = false;
+		return { { "ok", true } };
+	} else if (command == "shutdown") {
+		return { { "ok", true } };
+	} else if (command != "load") {
+		return error("unknown command '" + command + "'");
+	}
+	auto start{ std::chrono::steady_clock::now() };
+	/* Load into a copy, so a bad request leaves the mission untouched */
+	Solver					solver{ concorde_ };
+	std::vector<std::pair<double, double> > waypoints{};
+	std::filesystem::path			csvFile{};
+	try {
+		if (request.contains("csv")) {
+			csvFile = expandTilde(request["csv"].get<std::string>());
+			solver.setCSVFile(csvFile);
+			if (!solver.readCSV()) {
+				return error("cannot read CSV");
+			}
+			waypoints = solver.getWaypoints();
+		} else if (request.contains("waypoints")) {
+			waypoints = request["waypoints"]
+					    .get<std::vector<
+						    std::pair<double, double> > >();
+			csvFile = request.value("name", "mission") + ".csv";
+		}
+	} catch (const json::exception &) {
+		return error("malformed waypoints");
+	}
+	if (waypoints.size() < 2) {
+		return error("at least two waypoints are required");
+	}
+	/* A cost matrix file beside the CSV changes the tour, so its path,
+	   size and modification time key the cache as well */
+	std::string costs{};
+	if (request.contains("csv")) {
+		auto		costFile{ csvFile };
+		std::error_code ec{};
+		costFile.replace_extension(".costs");
+		auto size{ std::filesystem::file_size(costFile, ec) };
+		if (!ec) {
+			costs = costFile.string() + ":" + std::to_string(size) +
+				":" +
+				std::to_string(std::filesystem::last_write_time(
+						       costFile, ec)
+						       .time_since_epoch()
+						       .count());
+		}
+	}
+	/* FNV-1a hash of waypoints and costs keys route cache */
+	std::uint64_t hash{ 0xcbf29ce484222325ULL };
+	for (const auto &[lat, lon] : waypoints) {
+		for (double x : { lat, lon }) {
+			hash ^= std::bit_cast<std::uint64_t>(x);
+			hash *= 0x100000001b3ULL;
+		}
+	}
+	for (unsigned char c : costs) {
+		hash ^= c;
+		hash *= 0x100000001b3ULL;
+	}
+	auto cached{ routeCache_.find(hash) };
+	bool hit{ cached != routeCache_.end() &&
+		  cached->second.waypoints == waypoints &&
+		  cached->second.costs == costs };
+	if (!hit) {
+		/* Solve off the real-time core, at normal priority */
+		realtime_.release();
+		/* Solve without plotting, which would dominate load time. A CSV
+		   is solved as readCSV() left it, with its costs and CSV rows */
+		if (!request.contains("csv")) {
+			solver.setWaypoints(waypoints);
+			solver.setCSVFile(csvFile);
+		}
+		solver.writeTSPFile();
+		solver.solveTSP();
+		solver.readTSPSolution();
+		if (solver.getTourOrder().size() != waypoints.size()) {
+			return error("solver failed");
+		}
+		routeCache_[hash] = { waypoints, solver.getTourOrder(),
+				      solver.csvRows(), costs };
+	}
+	const auto &route{ routeCache_[hash] };
+	concorde_ = std::move(solver);
+	/* Swap in mission, restarting its log */
+	if (logFile_.is_open()) {
+		logFile_.close();
+	}
+	csvFile_ = csvFile;
+	if (!loadTour(waypoints, route.order, route.csvRows)) {
+		return error("cannot load tour");
+	}
+	keepMissionState();
+	serving_ = true;
+	auto end{ std::chrono::steady_clock::now() };
+	logPrint("(System Message) Mission loaded: " + csvFile_.stem().string(),
+		 true);
+	return { { "ok", true },
+		 { "mission", csvFile_.stem().string() },
+		 { "waypoints", waypoints.size() },
+		 { "cached", hit },
+		 { "length", legs_.total() },
+		 { "load_ms",
+		   std::chrono::duration<double, std::milli>(end - start)
+			   .count() } };
+}
+
+/* Helper method to write waypoints to CSV file in 'route' order */
+static bool writeRouteCSV(const std::filesystem::path		      &file,
+			  const std::vector<std::pair<double, double> > &waypoints,
+			  const std::vector<std::size_t>		      &route)
+{
+	std::ofstream out{ file };
+	if (!out) {
+		std::cerr << "Error opening file '" << file << "'.\n";
+		return false;
+	}
+	out << "latitude,longitude\n" << std::setprecision(10);
+	for (std::size_t idx : route) {
+		out << waypoints[idx].first << "," << waypoints[idx].second
+		    << "\n";
+	}
+	return true;
+}
+
+/* CLI mode to partition a mission across a fleet of vehicles (mTSP) */
+/* Solves the whole CSV as one giant tour, splits it into min-max balanced
+   routes sharing the starting position, then re-solves every vehicle's route
+   in parallel. Each route is written to '<CSV>_v<k>.csv' in the solution
+   directory in visiting order, ready for loadTourFile() */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::mtsp(void)
+{
+	/* Enter waypoint CSV path */
+	while (true) {
+		if (readCSV()) {
+			break;
+		}
+		retry("Reading CSV failed.", options_.csv.has_value());
+	}
+	/* Enter fleet size */
+	std::size_t vehicles{ options_.vehicles.value_or(0) };
+	if (options_.vehicles && !vehicles) {
+		retry("Number of vehicles not valid.", true);
+	}
+	while (!vehicles) {
+		std::cout << "Enter number of vehicles: ";
+		if (std::cin >> vehicles && vehicles > 0) {
+			std::cout << "\n";
+			break;
+		}
+		vehicles = 0;
+		std::cin.clear();
+		retryPrompt("Number of vehicles not valid.");
+	}
+	/* Set directories for Concorde */
+	setDirectories(false, false);
+	/* Solve giant tour */
+	concordeTSP();
+	const auto &waypoints{ concorde_.getWaypoints() };
+	if (tourOrder_.size() != waypoints.size()) {
+		std::cerr << "Error: Unable to solve tour over all waypoints.\n";
+		quit(1);
+	}
+	/* Partition giant tour into one route per vehicle */
+	FleetPartitioner partitioner{ waypoints, tourOrder_ };
+	auto		 routes{ partitioner.partition(vehicles) };
+	if (routes.size() < vehicles) {
+		std::cout << "Only " << routes.size()
+			  << " vehicles needed, one per waypoint.\n";
+	}
+	/* Re-solve every vehicle's route on its own solver and thread */
+	std::vector<std::filesystem::path> files(routes.size());
+	std::atomic<std::size_t>	   nextRoute{ 0 };
+	auto worker{ [&](void) {
+		for (std::size_t k = nextRoute++; k < routes.size();
+		     k		   = nextRoute++) {
+			auto &route{ routes[k] };
+			files[k] = concorde_.getSolDir() /
+				   (csvFile_.stem().string() + "_v" +
+				    std::to_string(k + 1) + ".csv");
+			if (!writeRouteCSV(files[k], waypoints, route)) {
+				continue;
+			}
+			/* Any order of three or fewer stops is optimal */
+			if (route.size() <= 3) {
+				continue;
+			}
+			ConcordeTSPSolver solver{ concorde_ };
+			solver.setVerbose(false);
+			solver.setCSVFile(files[k]);
+			if (!solver.readCSV()) {
+				continue;
+			}
+			solver.writeTSPFile();
+			solver.solveTSP();
+			solver.readTSPSolution();
+			const auto &order{ solver.getTourOrder() };
+			/* Keep partition order if solver failed */
+			if (order.size() != route.size()) {
+				continue;
+			}
+			solver.plotTSPSolution();
+			/* Rotate solved order to start at starting position */
+			std::vector<std::size_t> solved(route.size());
+			auto start{ std::find(order.begin(), order.end(), 0) };
+			std::rotate_copy(order.begin(), start, order.end(),
+					 solved.begin());
+			for (auto &idx : solved) {
+				idx = route[idx];
+			}
+			route = std::move(solved);
+			writeRouteCSV(files[k], waypoints, route);
+		}
+	} };
+	unsigned threads{ std::max(std::thread::hardware_concurrency(), 1U) };
+	std::vector<std::jthread> pool{};
+	for (unsigned i = 0; i < threads && i < routes.size(); i++) {
+		pool.emplace_back(worker);
+	}
+	pool.clear(); /* Join workers */
+	/* Report route per vehicle and fleet balance */
+	double longest{ 0.0 };
+	double shortest{ std::numeric_limits<double>::max() };
+	for (std::size_t k = 0; k < routes.size(); k++) {
+		double length{ partitioner.routeLength(routes[k]) };
+		longest	 = std::max(longest, length);
+		shortest = std::min(shortest, length);
+		std::cout << "Vehicle " << k + 1 << ": " << routes[k].size() - 1
+			  << " waypoints, " << std::fixed << std::setprecision(1)
+			  << length << " m, " << files[k] << "\n"
+			  << std::defaultfloat << std::setprecision(6);
+	}
+	std::cout << "\033[1;32m"
+		  << "Fleet mission partitioned. Longest route " << std::fixed
+		  << std::setprecision(1) << longest << " m, shortest "
+		  << shortest << " m.\n"
+		  << "\033[0m" << std::defaultfloat << std::setprecision(6);
+	quit(0);
+}
+
+/* Summarize telemetry log written by run, resume or serve */
+/* Prints per-leg statistics as CSV, and writes them to the export file if
+   given */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::analyze(void)
+{
+	using namespace std::chrono;
+	auto file{ readPath("Enter telemetry file: ", options_.telemetry) };
+	/* Map log and analyze it in one pass */
+	TelemetryLog log{};
+	if (!log.open(file)) {
+		std::cerr << "Error: " << file
+			  << " is missing or not a telemetry file.\n";
+		quit(1);
+	}
+	auto start{ steady_clock::now() };
+	auto legs{ log.analyze() };
+	auto end{ steady_clock::now() };
+	TelemetryLog::writeCSV(std::cout, legs);
+	/* Export CSV, if asked */
+	if (options_.exportFile) {
+		auto	      path{ expandTilde(*options_.exportFile) };
+		std::ofstream out{ path };
+		TelemetryLog::writeCSV(out, legs);
+		if (!out) {
+			std::cerr << "Error: cannot write " << path << ".\n";
+			quit(1);
+		}
+	}
+	/* Report totals */
+	std::size_t reached{ 0 };
+	double	    time{ 0.0 };
+	double	    distance{ 0.0 };
+	for (const auto &leg : legs) {
+		reached += leg.reached;
+		time += leg.time;
+		distance += leg.distance;
+	}
+	std::cout << "\033[1;32m" << "Analyzed " << log.records().size()
+		  << " records in " << std::fixed << std::setprecision(3)
+		  << duration<double, std::milli>(end - start).count()
+		  << " ms. " << reached << " of " << legs.size()
+		  << " legs reached, " << std::setprecision(1) << distance
+		  << " m in " << time << " s.\n"
+		  << "\033[0m" << std::defaultfloat << std::setprecision(6);
+	quit(0);
+}
+
+/* CLI mode to replay a telemetry log through the navigator */
+/* Loads the tour from the mission bundle, if given, else from the mission
+   state kept by 'run', and steers a ReplayNavigator with this navigator's
+   settings from the position of each recorded tick, played back as a fix at
+   its recorded time on ReplayClock. Prints the arrivals, so a recorded drive
+   can be checked again at another radius or with filtering */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::replay(void)
+{
+	using namespace std::chrono;
+	auto	     file{ readPath("Enter telemetry file: ", options_.telemetry) };
+	TelemetryLog log{};
+	if (!log.open(file)) {
+		std::cerr << "Error: " << file
+			  << " is missing or not a telemetry file.\n";
+		quit(1);
+	}
+	/* Load tour the log was recorded on */
+	if (options_.bundle) {
+		loadBundle(expandTilde(*options_.bundle));
+	} else {
+		auto statePath{ options_.state ? expandTilde(*options_.state) :
+					 MissionState::defaultPath() };
+		MissionState state{};
+		if (!state.open(statePath) ||
+		    !concorde_.setTour(state.waypoints(), state.order(),
+				       state.csvRows())) {
+			std::cerr << "Error: No mission to replay in "
+				  << statePath << ".\n";
+			quit(1);
+		}
+	}
+	/* Ticks' positions become fixes, with heading, speed and error
+	   estimates unknown */
+	constexpr double    nan{ std::numeric_limits<double>::quiet_NaN() };
+	std::vector<GPSFix> fixes{};
+	for (const auto &record : log.records()) {
+		if (record.event == TelemetryEvent::tick) {
+			fixes.push_back({ record.latitude, record.longitude, nan,
+					  nan,
+					  static_cast<double>(record.timestamp) *
+						  1e-9,
+					  nan, nan });
+		}
+	}
+	if (fixes.empty()) {
+		std::cerr << "Error: " << file << " has no ticks to replay.\n";
+		quit(1);
+	}
+	/* Mirror this navigator's settings onto a quiet in-process navigator */
+	ReplayNavigator nav{};
+	nav.setProximityRadius(proximityRadius_);
+	nav.setNavigationFrame(navFrame_);
+	nav.setCommandRate(commandRate_);
+	nav.setKalmanFilter(filter_);
+	nav.setOvershootDetection(overshoot_);
+	nav.setVerbose(false);
+	nav.loadTour(concorde_.getWaypoints(), tourOrder_,
+		     concorde_.csvRows());
+	std::size_t count{ fixes.size() };
+	ReplayClock::reset();
+	nav.positionSource().load(std::move(fixes));
+	/* Navigate until tour completes or fixes run out */
+	auto elapsed{ [] {
+		return duration<double>(ReplayClock::now().time_since_epoch())
+			.count();
+	} };
+	auto	    start{ steady_clock::now() };
+	json	    arrivals = json::array();
+	std::size_t ticks{ 0 };
+	std::size_t prev{ nav.getNextDest() };
+	for (; nav.getOutput(); ticks++) {
+		if (std::size_t next{ nav.getNextDest() }; next != prev) {
+			arrivals.push_back(
+				{ { "waypoint",
+				    concorde_.csvIndex(tourOrder_[prev]) },
+				  { "time", elapsed() } });
+			prev = next;
+		}
+	}
+	bool completed{ nav.getCommand().completed != 0 };
+	if (completed) {
+		arrivals.push_back(
+			{ { "waypoint", concorde_.csvIndex(tourOrder_[prev]) },
+			  { "time", elapsed() } });
+	}
+	auto end{ steady_clock::now() };
+	json j{ { "replay",
+		  { { "completed", completed },
+		    { "fixes", count },
+		    { "ticks", ticks },
+		    { "time", elapsed() },
+		    { "arrivals", arrivals },
+		    { "wall_time", duration<double>(end - start).count() } } } };
+	std::cout << j.dump(2) << "\n";
+	quit(0);
+}
+
+/* Benchmark solvers end to end on generated missions */
+/* Each shape and size is solved by the builtin heuristic and, if it is
+   installed, the linkern-compatible solver. A CSV row is printed per run as
+   it completes, and the table is written to the export file if given */
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::benchSolve(void)
+{
+	SolveBenchmark bench{};
+	if (options_.shapes) {
+		auto shapes{ splitList(*options_.shapes) };
+		for (const auto &shape : shapes) {
+			if (std::ranges::find(MissionGenerator::shapes(),
+					      shape) ==
+			    MissionGenerator::shapes().end()) {
+				std::cerr << "Error: unknown shape '" << shape
+					  << "'.\n";
+				quit(1);
+			}
+		}
+		bench.setShapes(std::move(shapes));
+	}
+	if (options_.sizes) {
+		std::vector<std::size_t> sizes{};
+		for (const auto &item : splitList(*options_.sizes)) {
+			std::size_t pos{ 0 };
+			std::size_t size{ 0 };
+			try {
+				size = std::stoull(item, &pos);
+			} catch (const std::exception &) {
+			}
+			/* Builtin solver indexes waypoints in 32 bits */
+			if (pos != item.size() || size < 2 ||
+			    size > std::numeric_limits<std::uint32_t>::max()) {
+				std::cerr << "Error: invalid mission size '"
+					  << item << "'.\n";
+				quit(1);
+			}
+			sizes.push_back(size);
+		}
+		bench.setSizes(std::move(sizes));
+	}
+	if (options_.repeats) {
+		bench.setRepeats(*options_.repeats);
+	}
+	if (options_.seed) {
+		bench.setSeed(*options_.seed);
+	}
+	bench.setClusters(options_.clusters);
+	bench.setTurnPenalty(options_.turnPenalty.value_or(0.0));
+	if (options_.solveTimeout) {
+		bench.setTimeout(
+			std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::duration<double>(
+					std::max(*options_.solveTimeout, 0.0))));
+	}
+	/* Benchmark external solver too, if installed */
+	std::vector<std::string> backends{ ConcordeTSPSolver::builtinSolver };
+	std::string		 solver{ options_.solver.value_or("linkern") };
+	if (solver != ConcordeTSPSolver::builtinSolver) {
+		if (ProcessRunner::available(solver)) {
+			backends.push_back(solver);
+		} else {
+			std::cerr << "Solver '" << solver
+				  << "' not found, benchmarking builtin only.\n";
+		}
+	}
+	bench.setBackends(std::move(backends));
+	/* Progress goes to stderr so stdout is just the table */
+	std::cerr << "Running " << bench.jobCount() << " benchmark runs.\n";
+	SolveBenchmark::writeHeader(std::cout);
+	auto rows{ bench.run([](const BenchRow &row) {
+		SolveBenchmark::writeRow(std::cout, row);
+		std::cout.flush();
+	}) };
+	/* Export CSV, if asked */
+	if (options_.exportFile) {
+		auto	      path{ expandTilde(*options_.exportFile) };
+		std::ofstream out{ path };
+		SolveBenchmark::writeHeader(out);
+		for (const auto &row : rows) {
+			SolveBenchmark::writeRow(out, row);
+		}
+		if (!out) {
+			std::cerr << "Error: cannot write " << path << ".\n";
+			quit(1);
+		}
+		std::cerr << "Wrote benchmark table: " << path << "\n";
+	}
+	quit(0);
 }
 
 /* User help print */
-[[noreturn]] void Navigator::help(void) noexcept
+template <NavigatorPolicy Policy>
+[[noreturn]] void BasicNavigator<Policy>::help(void) noexcept
 {
 	std::cout
-		<< "Usage: " << prog_ << " COMMAND\n\n"
+		<< "Usage: " << prog_ << " COMMAND [OPTIONS]\n\n"
 		<< "Autonomous waypoint navigation system for a mobile platform using Raspberry Pi 5\n\n"
 		<< "Commands:\n"
 		<< "  gpspoll        Poll GPS to get a reading\n"
 		<< "  run            Use GPS data to guide platform along a predefined series of static waypoints and output logs\n"
+		<< "  resume         Continue mission interrupted during run from its saved state\n"
+		<< "  simulate       Simulate mission over solved waypoints offline and faster than real time and report results\n"
+		<< "  serve          Keep GPS and solved routes warm and navigate missions requested over a Unix domain socket\n"
 		<< "  solve          Use Concorde TSP to solve directory of CSV waypoint files and output solutions as plotted graphs\n"
+		<< "  compile        Solve CSV waypoint file into a mission bundle that run --bundle starts from without solving\n"
+		<< "  batch          Simulate solved CSV waypoint files across a grid of navigation parameters and summarize results\n"
+		<< "  mtsp           Partition CSV waypoint file across a fleet of vehicles and solve each vehicle's tour\n"
+		<< "  analyze        Summarize per-leg time, distance and tick latency from a binary telemetry log\n"
+		<< "  replay         Steer along a kept mission from the positions in a binary telemetry log and report arrivals\n"
+		<< "  bench-solve    Time solvers on generated missions of growing size and report wall time, peak memory and tour length\n"
 		<< "  help           Show this help message and exit\n"
-		<< "\nExamples:\n"
+		<< "\n"
+		<< NavOptions::usage() << "\nExamples:\n"
 		<< "  " << prog_ << " run\n"
-		<< "  " << prog_ << " solve\n";
-	std::exit(0);
+		<< "  " << prog_ << " solve\n"
+		<< "  " << prog_
+		<< " run --csv ~/csv/route.csv --tsp-dir ~/tsp --sol-dir ~/sol --graph-dir ~/graph --no-log --radius 5\n"
+		<< "  " << prog_ << " run --config ~/awns-rpi5.json\n";
+	quit(0);
 }
+
+/* Navigators for the policies in policy.hpp */
+template class BasicNavigator<ProductionPolicy>;
+template class BasicNavigator<ReplayPolicy>;
@@ -2,28 +2,76 @@
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <fstream>
+#include <optional>
+#include <unordered_map>
 
+#include "command.hpp"
 #include "concorde.hpp"
 #include "gps.hpp"
+#include "kalman.hpp"
+#include "mission.hpp"
+#include "navframe.hpp"
+#include "options.hpp"
+#include "policy.hpp"
+#include "realtime.hpp"
+#include "route.hpp"
+#include "stream.hpp"
+#include "telemetry.hpp"
 
 using json = nlohmann::json;
 
-class Navigator {
+/* Navigator built from 'Policy', see policy.hpp. Navigator navigates from
+   gpsd in real time and ReplayNavigator replays fixes on a virtual clock */
+template <NavigatorPolicy Policy> class BasicNavigator {
     public:
-	Navigator(int argc, const char **argv) noexcept;
-	~Navigator(void);
+	using PositionSource = typename Policy::PositionSource;
+	using Clock	     = typename Policy::Clock;
+	using WallClock	     = typename Policy::WallClock;
+	using Solver	     = typename Policy::Solver;
+	using Sink	     = typename Policy::Sink;
+
+	BasicNavigator(int argc, const char **argv) noexcept;
+	BasicNavigator(void) noexcept;
+	~BasicNavigator(void);
 	void		    start(void);
 	void		    setProximityRadius(double) noexcept;
 	void		    setSimulationVelocity(double) noexcept;
+	void		    setNavigationFrame(bool) noexcept;
+	void		    setCommandRate(double) noexcept;
+	void		    setKalmanFilter(bool) noexcept;
+	void		    setVerbose(bool) noexcept;
+	void		    setOvershootDetection(bool) noexcept;
+	bool		    setCommandChannel(const std::string &);
+	bool setCommandStream(const std::string &, StreamFormat);
+	bool setTelemetryFile(const std::filesystem::path &);
+	bool setRealtimeProfile(std::optional<std::size_t>, int);
 	std::optional<json> getOutput(void);
 
+	bool loadTour(const std::vector<std::pair<double, double> > &,
+		      const std::vector<std::size_t> &,
+		      const std::vector<std::size_t> & = {});
+	bool		      loadTourFile(const std::filesystem::path &);
+	std::optional<double> steer(const GPSFix &);
+	std::size_t	      getNextDest(void) const noexcept;
+	RouteProgress	      getProgress(void) const noexcept;
+	const std::vector<std::pair<double, double> > &getTour(void) const noexcept;
+	const std::vector<std::size_t> &getTourOrder(void) const noexcept;
+	NavCommand			getCommand(void) const noexcept;
+	const JitterHistogram	       &getJitter(void) const noexcept;
+	PositionSource		       &positionSource(void) noexcept;
+
     private:
 	static constexpr double earthRadius_{
 		6371000.0
 	}; /* Earth's radius in meters */
-	GPSClient	  gps_;	     /* GPS client */
-	ConcordeTSPSolver concorde_; /* Concorde TSP solver */
+	inline static const char *defaultArgv_[]{
+		"awns-rpi5", nullptr
+	}; /* Args for in-process use without a CLI */
+	PositionSource gps_;	  /* GPS position source */
+	Solver	       concorde_; /* TSP solver */
+	Sink	       sink_;	  /* Printed output */
 	const char	 *prog_;     /* Executable name */
 	const int	  argc_;     /* User arg count */
 	const char	**argv_;     /* User arg vector */
@@ -47,19 +95,109 @@ class Navigator {
 					  files */
 	std::filesystem::path csvFile_;	 /* Path to CSV file for run mode */
 	std::ofstream	      logFile_;	 /* Optional log file stream */
+	bool		      navFrame_; /* Flag to mark whether per-tick math
+					    runs in local navigation frame */
+	LocalFrame	      frame_;	 /* Local east-north navigation frame */
+	LocalFrame::Point     currLocal_; /* Current position in frame */
+	static constexpr std::chrono::milliseconds drHorizon_{
+		2000
+	}; /* Longest dead-reckoning extrapolation before blocking for a fix */
+	double commandRate_; /* Rate of dead-reckoned output in Hz */
+	typename Clock::time_point nextTick_;	 /* Deadline of next output
+						    tick */
+	typename Clock::time_point lastFixTick_; /* Arrival time of last fix */
+	std::chrono::steady_clock::time_point tickStart_; /* Time tick's input
+							     became ready */
+	std::optional<GPSFix> lastFix_;	   /* Last real GPS fix */
+	LocalFrame	      drFrame_;	   /* Frame anchored at last fix */
+	LocalFrame::Point     drVelocity_; /* East, north velocity in meters
+					      per second */
+	static constexpr double defaultFixSigma_{
+		3.0
+	}; /* Fix standard deviation in meters when gpsd reports none */
+	bool	     filter_;  /* Flag to mark whether GPS fixes are smoothed */
+	KalmanFilter kalman_;  /* Position/velocity filter */
+	LocalFrame   kfFrame_; /* Frame the filter state is expressed in */
+	double	     kfTime_;  /* Timestamp of last fused fix */
+	bool overshoot_; /* Flag to mark whether arrival also tests the path
+			    travelled since last tick */
+	bool hasPrev_;	 /* Flag to mark whether prevPos_ is set */
+	std::pair<double, double> prevPos_;  /* Position at last tick */
+	std::size_t		  legDest_;  /* Destination legFrame_ is
+						anchored at */
+	LocalFrame		  legFrame_; /* Frame anchored at destination */
+	LocalFrame::Point	  legFrom_;  /* Leg's starting waypoint in
+						legFrame_ */
+	LegTable legs_;		/* Per-leg route table */
+	double	 destDistance_; /* Distance to next destination in meters */
+	double	 groundSpeed_;	/* Speed over ground in meters per second,
+				   negative if unknown */
+	bool	     verbose_;	/* Flag to mark whether output is printed */
+	bool	     offline_;	/* Flag to mark offline simulation mode */
+	bool	     reported_; /* Flag to mark offline simulation has run */
+	bool	     completed_; /* Flag to mark the tour has completed */
+	CommandPublisher channel_; /* Shared-memory command channel */
+	CommandStream	 stream_;  /* Unix domain socket command stream */
+	MissionState	 state_;   /* Memory-mapped mission state */
+	TelemetryWriter	 telemetry_; /* Binary telemetry log */
+	RealtimeProfile	 realtime_;  /* Real-time profile of navigation
+					thread */
+	JitterHistogram	 jitter_;    /* Tick wake-up lateness */
+	NavOptions	 options_; /* Command line and config file options */
+	bool		 interrupted_; /* Flag to mark tick was cut short by
+					  a request, see waitFix() */
+	bool		 serving_; /* Flag to mark 'serve' is navigating */
+	/* Solved tour of a served mission */
+	struct CachedRoute {
+		std::vector<std::pair<double, double> > waypoints; /* As solved */
+		std::vector<std::size_t>		order;	   /* Visiting
+								      order */
+		std::vector<std::size_t>		csvRows;   /* CSV row of
+								      each
+								      waypoint */
+		std::string costs; /* Identity of cost matrix file, if any */
+	};
+	std::unordered_map<std::uint64_t, CachedRoute>
+		routeCache_; /* Solved tours by hash of waypoints and costs */
 
 	void		  run(void);
+	void		  resume(void);
+	void		  simulate(void);
 	void		  gpspoll(bool);
 	[[noreturn]] void solve(void);
+	[[noreturn]] void compile(void);
+	[[noreturn]] void watchSolutions(void);
+	[[noreturn]] void batch(void);
+	[[noreturn]] void mtsp(void);
+	[[noreturn]] void serve(void);
+	[[noreturn]] void analyze(void);
+	[[noreturn]] void replay(void);
+	[[noreturn]] void benchSolve(void);
 	[[noreturn]] void help(void) noexcept;
+	[[noreturn]] void quit(int) noexcept;
 
 	void		      stop(void);
+	std::optional<GPSFix> waitFix(void);
 	std::optional<json>   gpsOutput(void);
 	std::optional<json>   simulationVelocityOutput(void);
+	std::optional<json>   deadReckoningOutput(void);
+	std::optional<json>   offlineOutput(void);
+	void		      publishCommand(const std::optional<json> &);
+	void		      recordTelemetry(TelemetryEvent,
+					      std::chrono::nanoseconds);
+	void		      reportJitter(void);
+	json		      serveRequest(const json &);
+	void		      keepMissionState(void);
+	void		      loadBundle(const std::filesystem::path &);
+	void resyncFix(const GPSFix &, typename Clock::time_point);
+	std::pair<double, double> filterFix(const GPSFix &);
+	json			  filterOutput(void);
+	json			  progressOutput(void);
 	std::tm		      localTime(void);
 	std::string	      getTimestamp(void);
 	void		      logPrint(const std::string &, bool);
 	std::string	      logCoordinates(const std::pair<double, double> &);
+	std::size_t	      waypointIndex(void) const noexcept;
 	void		      setupForNavOutput(void);
 	bool		      testGPSConnection(void);
 	bool		      readCSV(void);
@@ -78,13 +216,24 @@ class Navigator {
 	void		      setDirectories(bool, bool);
 	std::optional<std::pair<double, double> > getDest(void);
 	void   retryPrompt(const char *) noexcept;
+	void   retry(const char *, bool);
+	void   applyOptions(void);
+	std::filesystem::path readPath(const char *,
+				       const std::optional<std::filesystem::path> &);
 	void   logFix(const GPSFix &) noexcept;
 	bool   waypointReached(const std::pair<double, double> &,
 			       const std::pair<double, double> &) const noexcept;
+	double greatCircleDistance(const std::pair<double, double> &,
+				   const std::pair<double, double> &) const noexcept;
+	double destDistance(void);
 	double calculateBearing(const std::pair<double, double> &,
 				const std::pair<double, double> &) noexcept;
 	std::pair<double, double>
 	computeNewPosition(const std::pair<double, double> &, double) noexcept;
+	void   frameUpdate(void);
+	bool   arrived(void);
+	bool   overshot(void);
+	double destBearing(void);
 
 	/* Inline utility methods to convert from degrees to radians and vice
 	   versa */
@@ -98,3 +247,6 @@ class Navigator {
 		return rad * 180.0 / M_PI;
 	}
 };
+
+using Navigator	      = BasicNavigator<ProductionPolicy>;
+using ReplayNavigator = BasicNavigator<ReplayPolicy>;
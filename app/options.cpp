@@ -0,0 +1,266 @@
+#include "options.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+/* Helpers converting option text to option type, throwing
+   std::invalid_argument if malformed */
+static void assign(std::optional<std::filesystem::path> &opt,
+		   const std::string			&value)
+{
+	opt = value;
+}
+
+static void assign(std::optional<std::string> &opt, const std::string &value)
+{
+	opt = value;
+}
+
+static void assign(std::optional<double> &opt, const std::string &value)
+{
+	std::size_t pos{};
+	double	    number{ std::stod(value, &pos) };
+	if (pos != value.size()) {
+		throw std::invalid_argument{ value };
+	}
+	opt = number;
+}
+
+static void assign(std::optional<std::size_t> &opt, const std::string &value)
+{
+	std::size_t pos{};
+	auto	    number{ std::stoull(value, &pos) };
+	if (pos != value.size() || value.starts_with('-')) {
+		throw std::invalid_argument{ value };
+	}
+	opt = number;
+}
+
+static void assign(std::optional<bool> &opt, const std::string &value)
+{
+	if (value == "true" || value == "yes" || value == "1") {
+		opt = true;
+	} else if (value == "false" || value == "no" || value == "0") {
+		opt = false;
+	} else {
+		throw std::invalid_argument{ value };
+	}
+}
+
+static void assign(std::optional<StreamFormat> &opt, const std::string &value)
+{
+	if (value == "binary") {
+		opt = StreamFormat::binary;
+	} else if (value == "cbor") {
+		opt = StreamFormat::cbor;
+	} else {
+		throw std::invalid_argument{ value };
+	}
+}
+
+/* Call 'f' with member of 'options' named 'name' */
+/* Returns false if there is no such option */
+template <typename F>
+static bool withField(NavOptions &options, std::string_view name,
+		      const auto &fields, F &&f)
+{
+	bool found{ false };
+	std::apply(
+		[&](const auto &...field) {
+			auto visit{ [&](const auto &entry) {
+				if (!found && name == entry.first) {
+					f(options.*entry.second);
+					found = true;
+				}
+			} };
+			(visit(field), ...);
+		},
+		fields);
+	return found;
+}
+
+/* Parse flags 'argv[0..argc)' as '--name value', '--name=value', '--name'
+   or '--no-name' */
+/* Throws std::invalid_argument naming the offending flag */
+void NavOptions::parse(int argc, const char *const *argv)
+{
+	for (int i = 0; i < argc; i++) {
+		std::string arg{ argv[i] };
+		if (!arg.starts_with("--")) {
+			throw std::invalid_argument{ "unexpected argument '" +
+						     arg + "'" };
+		}
+		/* Split off inline value */
+		std::optional<std::string> value{};
+		std::string		   name{ arg.substr(2) };
+		if (auto eq{ name.find('=') }; eq != std::string::npos) {
+			value = name.substr(eq + 1);
+			name.erase(eq);
+		}
+		std::replace(name.begin(), name.end(), '-', '_');
+		auto apply{ [&](auto &opt) {
+			using T = std::remove_cvref_t<decltype(opt)>;
+			if constexpr (std::is_same_v<T, std::optional<bool> >) {
+				if (!value) {
+					opt = true;
+					return;
+				}
+			}
+			if (!value) {
+				if (i + 1 >= argc) {
+					throw std::invalid_argument{
+						"option '" + arg +
+						"' expects a value"
+					};
+				}
+				value = argv[++i];
+			}
+			try {
+				assign(opt, *value);
+			} catch (const std::exception &) {
+				throw std::invalid_argument{ "option '" + arg +
+							     "' has invalid value '" +
+							     *value + "'" };
+			}
+		} };
+		if (withField(*this, name, fields_, apply)) {
+			continue;
+		}
+		/* '--no-name' turns off switch 'name' */
+		bool negated{ name.starts_with("no_") && !value &&
+			      withField(*this, name.substr(3), fields_,
+					[&](auto &opt) {
+						using T = std::remove_cvref_t<
+							decltype(opt)>;
+						if constexpr (std::is_same_v<
+								      T,
+								      std::optional<
+									      bool> >) {
+							opt = false;
+						} else {
+							throw std::invalid_argument{
+								"unknown option '" +
+								arg + "'"
+							};
+						}
+					}) };
+		if (!negated) {
+			throw std::invalid_argument{ "unknown option '" + arg +
+						     "'" };
+		}
+	}
+}
+
+/* Load options from JSON object in config file 'file' */
+/* Throws std::invalid_argument naming the offending key */
+void NavOptions::load(const std::filesystem::path &file)
+{
+	std::ifstream in{ file };
+	if (!in) {
+		throw std::invalid_argument{ "cannot open config file '" +
+					     file.string() + "'" };
+	}
+	json config = json::parse(in, nullptr, false);
+	if (!config.is_object()) {
+		throw std::invalid_argument{ "config file '" + file.string() +
+					     "' is not a JSON object" };
+	}
+	for (const auto &[key, value] : config.items()) {
+		auto apply{ [&](auto &opt) {
+			using T = typename std::remove_cvref_t<
+				decltype(opt)>::value_type;
+			try {
+				if (value.is_string()) {
+					assign(opt, value.get<std::string>());
+				} else if constexpr (std::is_arithmetic_v<T>) {
+					opt = value.get<T>();
+				} else {
+					throw std::invalid_argument{ key };
+				}
+			} catch (const std::exception &) {
+				throw std::invalid_argument{
+					"config key '" + key +
+					"' has invalid value " + value.dump()
+				};
+			}
+		} };
+		if (!withField(*this, key, fields_, apply)) {
+			throw std::invalid_argument{ "unknown config key '" +
+						     key + "'" };
+		}
+	}
+}
+
+/* Fill options not given here from 'other' */
+void NavOptions::merge(const NavOptions &other)
+{
+	std::apply(
+		[&](const auto &...field) {
+			auto fill{ [&](const auto &f) {
+				if (!(this->*f.second)) {
+					this->*f.second = other.*f.second;
+				}
+			} };
+			(fill(field), ...);
+		},
+		fields_);
+}
+
+/* Help text for options */
+const char *NavOptions::usage(void) noexcept
+{
+	return "Options:\n"
+	       "  --config FILE          Read options from JSON config file, e.g. {\"csv_dir\": \"~/csv\", \"radius\": 5}\n"
+	       "  --csv FILE             Waypoint CSV file\n"
+	       "  --csv-dir DIR          CSV waypoint directory\n"
+	       "  --tsp-dir DIR          TSP directory\n"
+	       "  --sol-dir DIR          Solution directory\n"
+	       "  --graph-dir DIR        Graph directory\n"
+	       "  --log-dir DIR          Log controller output to directory\n"
+	       "  --no-log               Do not log controller output\n"
+	       "  --state FILE           Mission state file for run, resume and replay\n"
+	       "  --bundle FILE          Mission bundle for run or replay to start from, or for compile to write\n"
+	       "  --[no-]watch           Keep solving CSV files as they are created or changed (solve)\n"
+	       "  --radius METERS        Proximity radius\n"
+	       "  --velocity M/S         Simulation velocity\n"
+	       "  --rate HZ              Command rate\n"
+	       "  --[no-]frame           Navigation frame\n"
+	       "  --[no-]filter          Kalman filtering of GPS fixes\n"
+	       "  --[no-]overshoot       Overshoot detection\n"
+	       "  --[no-]verbose         Print navigation output\n"
+	       "  --solver PATH          linkern-compatible solver executable, or builtin for the in-process heuristic\n"
+	       "  --solve-timeout SECS   Kill solver runs after this long, 0 for no limit (default 300)\n"
+	       "  --consolidate METERS   Merge waypoints this close together before solving\n"
+	       "  --clusters K           Solve in K clusters in parallel and stitch them, 0 to choose K by size\n"
+	       "  --turn-penalty METERS  Distance a full reversal of heading at a waypoint costs, to optimise for drive time\n"
+	       "  --elevation FILE       ESRI ASCII elevation grid to estimate uphill and downhill traversal costs from\n"
+	       "  --channel NAME         Shared-memory command channel (run, resume, serve)\n"
+	       "  --stream PATH          Unix domain socket command stream (run, resume, serve)\n"
+	       "  --stream-format FMT    Command stream format, binary or cbor\n"
+	       "  --vehicles N           Number of vehicles for mtsp\n"
+	       "  --socket PATH          Unix domain socket for serve\n"
+	       "  --telemetry FILE       Append binary telemetry to file, or file for analyze or replay to read\n"
+	       "  --export FILE          Write analyze's or bench-solve's table to CSV file\n"
+	       "  --shapes LIST          Comma-separated shapes for bench-solve (default line,spiral,clusters,oneside,allaround)\n"
+	       "  --sizes LIST           Comma-separated waypoint counts for bench-solve (default 10,100,1000,10000)\n"
+	       "  --repeats N            Runs per shape, size and solver for bench-solve (default 3)\n"
+	       "  --seed N               Seed of missions generated by bench-solve (default 1)\n"
+	       "  --noise LIST           Comma-separated GPS noise models for batch, none, white-SIGMAm or markov-SIGMAm (default none,white-3m,markov-3m)\n"
+	       "  --velocities LIST      Comma-separated velocities for batch in m/s (default --velocity, else 2,5,10,20)\n"
+	       "  --radii LIST           Comma-separated proximity radii for batch in meters (default --radius, else 5,10,20)\n"
+	       "  --ticks LIST           Comma-separated tick periods for batch in seconds (default 0.2,1,2)\n"
+	       "  --trials N             Seeded trials per grid point for batch (default 4)\n"
+	       "  --[no-]realtime        Pin navigation to a core under SCHED_FIFO with memory locked\n"
+	       "  --rt-cpu N             Core to pin navigation to (default first isolated core, else last core)\n"
+	       "  --rt-priority N        SCHED_FIFO priority of navigation, 1 to 99 (default 49)\n";
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "stream.hpp"
+
+using json = nlohmann::json;
+
+/* Command line and config file options. Every option is optional; one that
+   is given skips its interactive prompt or overrides its API setter. Flags
+   are '--name value' (or '--name' and '--no-name' for switches) and config
+   file keys are the same names with underscores, e.g. '--csv-dir' and
+   "csv_dir". Flags win over the config file */
+struct NavOptions {
+	std::optional<std::filesystem::path> config;   /* JSON config file */
+	std::optional<std::filesystem::path> csv;      /* Waypoint CSV file */
+	std::optional<std::filesystem::path> csvDir;   /* CSV directory */
+	std::optional<std::filesystem::path> tspDir;   /* TSP directory */
+	std::optional<std::filesystem::path> solDir;   /* Solution directory */
+	std::optional<std::filesystem::path> graphDir; /* Graph directory */
+	std::optional<std::filesystem::path> logDir;   /* Log directory */
+	std::optional<bool>		     log;      /* Whether to log */
+	std::optional<std::filesystem::path> state;    /* Mission state file */
+	std::optional<std::filesystem::path> bundle;   /* Mission bundle */
+	std::optional<bool>		     watch;    /* Keep solving */
+	std::optional<double>		     radius;   /* Proximity radius */
+	std::optional<double>		     velocity; /* Simulation velocity */
+	std::optional<double>		     rate;     /* Command rate */
+	std::optional<bool>		     frame;    /* Navigation frame */
+	std::optional<bool>		     filter;   /* Kalman filter */
+	std::optional<bool>		     overshoot; /* Overshoot detection */
+	std::optional<bool>		     verbose;	/* Print output */
+	std::optional<std::string>	     solver;	/* linkern executable */
+	std::optional<double>		     solveTimeout; /* Solver deadline in seconds */
+	std::optional<double>		     consolidate;  /* Merge radius */
+	std::optional<std::size_t>	     clusters;	   /* Decomposition */
+	std::optional<double>		     turnPenalty;  /* Meters per
+							      reversal */
+	std::optional<std::filesystem::path> elevation;	   /* Elevation grid */
+	std::optional<std::string>	     channel;	/* Shared-memory channel */
+	std::optional<std::string>	     stream;	/* Command stream socket */
+	std::optional<StreamFormat>	     streamFormat; /* Stream format */
+	std::optional<std::size_t>	     vehicles;	   /* Fleet size */
+	std::optional<std::filesystem::path> socket;	   /* serve socket */
+	std::optional<std::filesystem::path> telemetry;	   /* Telemetry file */
+	std::optional<std::filesystem::path> exportFile;   /* analyze or
+							      bench-solve CSV */
+	std::optional<std::string>	     shapes;	   /* bench-solve shapes */
+	std::optional<std::string>	     sizes;	   /* bench-solve sizes */
+	std::optional<std::size_t>	     repeats;	   /* bench-solve runs */
+	std::optional<std::size_t>	     seed;	   /* bench-solve seed */
+	std::optional<std::string>	     noise;	   /* batch noise models */
+	std::optional<std::string>	     velocities;   /* batch speeds */
+	std::optional<std::string>	     radii;	   /* batch radii */
+	std::optional<std::string>	     ticks;	   /* batch tick periods */
+	std::optional<std::size_t>	     trials;	   /* batch trials */
+	std::optional<bool>		     realtime;	   /* Real-time profile */
+	std::optional<std::size_t>	     rtCpu;	   /* Core to pin to */
+	std::optional<std::size_t>	     rtPriority;   /* SCHED_FIFO
+							      priority */
+
+	void parse(int, const char *const *);
+	void load(const std::filesystem::path &);
+	void merge(const NavOptions &);
+
+	static const char *usage(void) noexcept;
+
+    private:
+	/* Option names and members, for parsing and merging generically */
+	static constexpr auto fields_{ std::make_tuple(
+		std::pair{ "config", &NavOptions::config },
+		std::pair{ "csv", &NavOptions::csv },
+		std::pair{ "csv_dir", &NavOptions::csvDir },
+		std::pair{ "tsp_dir", &NavOptions::tspDir },
+		std::pair{ "sol_dir", &NavOptions::solDir },
+		std::pair{ "graph_dir", &NavOptions::graphDir },
+		std::pair{ "log_dir", &NavOptions::logDir },
+		std::pair{ "log", &NavOptions::log },
+		std::pair{ "state", &NavOptions::state },
+		std::pair{ "bundle", &NavOptions::bundle },
+		std::pair{ "watch", &NavOptions::watch },
+		std::pair{ "radius", &NavOptions::radius },
+		std::pair{ "velocity", &NavOptions::velocity },
+		std::pair{ "rate", &NavOptions::rate },
+		std::pair{ "frame", &NavOptions::frame },
+		std::pair{ "filter", &NavOptions::filter },
+		std::pair{ "overshoot", &NavOptions::overshoot },
+		std::pair{ "verbose", &NavOptions::verbose },
+		std::pair{ "solver", &NavOptions::solver },
+		std::pair{ "solve_timeout", &NavOptions::solveTimeout },
+		std::pair{ "consolidate", &NavOptions::consolidate },
+		std::pair{ "clusters", &NavOptions::clusters },
+		std::pair{ "turn_penalty", &NavOptions::turnPenalty },
+		std::pair{ "elevation", &NavOptions::elevation },
+		std::pair{ "channel", &NavOptions::channel },
+		std::pair{ "stream", &NavOptions::stream },
+		std::pair{ "stream_format", &NavOptions::streamFormat },
+		std::pair{ "vehicles", &NavOptions::vehicles },
+		std::pair{ "socket", &NavOptions::socket },
+		std::pair{ "telemetry", &NavOptions::telemetry },
+		std::pair{ "export", &NavOptions::exportFile },
+		std::pair{ "shapes", &NavOptions::shapes },
+		std::pair{ "sizes", &NavOptions::sizes },
+		std::pair{ "repeats", &NavOptions::repeats },
+		std::pair{ "seed", &NavOptions::seed },
+		std::pair{ "noise", &NavOptions::noise },
+		std::pair{ "velocities", &NavOptions::velocities },
+		std::pair{ "radii", &NavOptions::radii },
+		std::pair{ "ticks", &NavOptions::ticks },
+		std::pair{ "trials", &NavOptions::trials },
+		std::pair{ "realtime", &NavOptions::realtime },
+		std::pair{ "rt_cpu", &NavOptions::rtCpu },
+		std::pair{ "rt_priority", &NavOptions::rtPriority }) };
+};
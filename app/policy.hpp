@@ -0,0 +1,234 @@
+#pragma once
+
+#include <time.h>
+
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "concorde.hpp"
+#include "gps.hpp"
+
+/* Policies that BasicNavigator is built from. A policy names its position
+   source, tick clock, wall clock, TSP solver and output sink as types, so
+   each navigator calls them directly with no virtual dispatch */
+
+/* Source of GPS fixes, e.g. GPSClient, whose waits for a fix can be cut
+   short by a wake descriptor becoming readable */
+template <typename T>
+concept PositionSource = requires(T source) {
+	{ source.connect() } -> std::convertible_to<bool>;
+	source.startStream();
+	source.stopStream();
+	{ source.waitReadFix() } -> std::same_as<std::optional<GPSFix> >;
+	{ source.pollFix() } -> std::same_as<std::optional<GPSFix> >;
+	source.setWakeFd(0);
+	{ source.woken() } -> std::convertible_to<bool>;
+};
+
+/* Monotonic clock that navigation ticks are scheduled on, which can also
+   wait until a time point */
+template <typename T>
+concept TickClock =
+	std::chrono::is_clock_v<T> && requires(typename T::time_point t) {
+		T::sleepUntil(t);
+	};
+
+/* Clock giving calendar time for timestamps */
+template <typename T>
+concept WallClock = std::chrono::is_clock_v<T> &&
+		    requires(typename T::time_point t) { T::to_time_t(t); };
+
+/* TSP solver holding waypoints and solved tour, e.g. ConcordeTSPSolver */
+template <typename T>
+concept TourSolver = requires(
+	T solver, const std::vector<std::pair<double, double> > &waypoints,
+	const std::vector<std::size_t> &order, std::filesystem::path path) {
+	{
+		solver.getWaypoints()
+	} -> std::same_as<const std::vector<std::pair<double, double> > &>;
+	{
+		solver.getTour()
+	} -> std::same_as<const std::vector<std::pair<double, double> > &>;
+	{
+		solver.getTourOrder()
+	} -> std::same_as<const std::vector<std::size_t> &>;
+	{ solver.csvIndex(order.size()) } -> std::convertible_to<std::size_t>;
+	{ solver.setTour(waypoints, order) } -> std::convertible_to<bool>;
+	{ solver.setTour(waypoints, order, order) } -> std::convertible_to<bool>;
+	solver.setWaypoints(waypoints);
+	solver.setCSVFile(path);
+	{ solver.readCSV() } -> std::convertible_to<bool>;
+	solver.writeTSPFile();
+	solver.solveTSP();
+	solver.readTSPSolution();
+};
+
+/* Destination of printed navigation output, one line per write */
+template <typename T>
+concept OutputSink = requires(T sink, std::string_view line) {
+	sink.write(line);
+};
+
+/* Policy with member types for each part of a navigator */
+template <typename P>
+concept NavigatorPolicy = PositionSource<typename P::PositionSource> &&
+			  TickClock<typename P::Clock> &&
+			  WallClock<typename P::WallClock> &&
+			  TourSolver<typename P::Solver> &&
+			  OutputSink<typename P::Sink>;
+
+/* Monotonic system clock, sleeping the calling thread to wait */
+/* The deadline is absolute, so preemption before the call does not delay
+   the wake-up */
+struct SteadyClock : std::chrono::steady_clock {
+	static void sleepUntil(time_point t)
+	{
+		auto ns{ std::chrono::duration_cast<std::chrono::nanoseconds>(
+				 t.time_since_epoch())
+				 .count() };
+		timespec ts{ static_cast<time_t>(ns / 1000000000),
+			     static_cast<long>(ns % 1000000000) };
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts,
+				       nullptr) == EINTR) {
+		}
+	}
+};
+
+/* Virtual monotonic clock for replay, which jumps instead of sleeping */
+/* Time is per thread, so replays on worker threads do not interfere */
+struct ReplayClock {
+	using duration			 = std::chrono::nanoseconds;
+	using rep			 = duration::rep;
+	using period			 = duration::period;
+	using time_point		 = std::chrono::time_point<ReplayClock>;
+	static constexpr bool is_steady = true;
+
+	static time_point now(void) noexcept
+	{
+		return now_;
+	}
+
+	static void sleepUntil(time_point t) noexcept
+	{
+		if (t > now_) {
+			now_ = t;
+		}
+	}
+
+	static void reset(void) noexcept
+	{
+		now_ = time_point{};
+	}
+
+    private:
+	inline static thread_local time_point now_{};
+};
+
+/* Position source replaying recorded fixes on ReplayClock */
+/* A fix is available once as much replay time has passed as separated it
+   from the first fix, and waiting for a fix jumps the clock to it */
+class ReplayGPS {
+    public:
+	void load(std::vector<GPSFix> fixes)
+	{
+		fixes_ = std::move(fixes);
+		next_  = 0;
+		start_ = ReplayClock::now();
+	}
+
+	bool connect(void) const noexcept
+	{
+		return !fixes_.empty();
+	}
+
+	void startStream(void) noexcept
+	{
+	}
+
+	void stopStream(void) noexcept
+	{
+	}
+
+	std::optional<GPSFix> waitReadFix(void)
+	{
+		if (next_ >= fixes_.size()) {
+			return std::nullopt;
+		}
+		ReplayClock::sleepUntil(due(next_));
+		return fixes_[next_++];
+	}
+
+	std::optional<GPSFix> pollFix(void)
+	{
+		if (next_ >= fixes_.size() || due(next_) > ReplayClock::now()) {
+			return std::nullopt;
+		}
+		return fixes_[next_++];
+	}
+
+	/* Replay never waits on real time, so is never woken */
+	void setWakeFd(int) noexcept
+	{
+	}
+
+	bool woken(void) const noexcept
+	{
+		return false;
+	}
+
+    private:
+	std::vector<GPSFix>	fixes_; /* Recorded fixes in time order */
+	std::size_t		next_{ 0 }; /* Index of next fix to report */
+	ReplayClock::time_point start_{};   /* Replay time of first fix */
+
+	ReplayClock::time_point due(std::size_t i) const
+	{
+		return start_ +
+		       std::chrono::duration_cast<ReplayClock::duration>(
+			       std::chrono::duration<double>(fixes_[i].time -
+							     fixes_[0].time));
+	}
+};
+
+/* Sink printing to stdout */
+struct ConsoleSink {
+	void write(std::string_view line)
+	{
+		std::cout << line;
+	}
+};
+
+/* Sink discarding output */
+struct NullSink {
+	void write(std::string_view) noexcept
+	{
+	}
+};
+
+/* Policy for navigating a vehicle from gpsd in real time */
+struct ProductionPolicy {
+	using PositionSource = GPSClient;
+	using Clock	     = SteadyClock;
+	using WallClock	     = std::chrono::system_clock;
+	using Solver	     = ConcordeTSPSolver;
+	using Sink	     = ConsoleSink;
+};
+
+/* Policy for replaying recorded fixes and offline simulation, running as fast
+   as the CPU allows */
+struct ReplayPolicy {
+	using PositionSource = ReplayGPS;
+	using Clock	     = ReplayClock;
+	using WallClock	     = std::chrono::system_clock;
+	using Solver	     = ConcordeTSPSolver;
+	using Sink	     = NullSink;
+};
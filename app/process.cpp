@@ -0,0 +1,324 @@
+#include "process.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+extern char **environ;
+
+/* Constructor */
+MemFile::MemFile(const char *name) noexcept
+	: fd_{ memfd_create(name, MFD_CLOEXEC) }
+{
+}
+
+/* Destructor */
+MemFile::~MemFile(void)
+{
+	if (fd_ >= 0) {
+		close(fd_);
+	}
+}
+
+/* Whether memfd was created */
+bool MemFile::isOpen(void) const noexcept
+{
+	return fd_ >= 0;
+}
+
+/* Getter for fd_ */
+int MemFile::fd(void) const noexcept
+{
+	return fd_;
+}
+
+/* Append 'data' to file */
+/* Returns false on failure */
+bool MemFile::write(std::string_view data)
+{
+	while (!data.empty()) {
+		ssize_t n{ ::write(fd_, data.data(), data.size()) };
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		data.remove_prefix(static_cast<std::size_t>(n));
+	}
+	return true;
+}
+
+/* Whole contents of file, as left by a child */
+std::string MemFile::read(void) const
+{
+	struct stat st {};
+	if (fd_ < 0 || fstat(fd_, &st) < 0) {
+		return {};
+	}
+	std::string data(static_cast<std::size_t>(st.st_size), '\0');
+	std::size_t got{ 0 };
+	while (got < data.size()) {
+		ssize_t n{ pread(fd_, data.data() + got, data.size() - got,
+				 static_cast<off_t>(got)) };
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			break;
+		}
+		got += static_cast<std::size_t>(n);
+	}
+	data.resize(got);
+	return data;
+}
+
+/* Path a child opens the i-th file passed to it by */
+std::string MemFile::childPath(std::size_t i)
+{
+	return "/dev/fd/" + std::to_string(3 + i);
+}
+
+/* Constructor */
+/* At most 'maxChildren' children run at once, or one per core if 0 */
+ProcessRunner::ProcessRunner(std::size_t maxChildren) noexcept
+	: maxChildren_{ maxChildren ?
+				maxChildren :
+				std::max(1u, std::thread::hardware_concurrency()) },
+	  active_{ 0 },
+	  cancelled_{ false },
+	  cancelFd_{ eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK) }
+{
+}
+
+/* Destructor */
+ProcessRunner::~ProcessRunner(void)
+{
+	cancel();
+	if (cancelFd_ >= 0) {
+		close(cancelFd_);
+	}
+}
+
+/* Start 'argv' with 'fds' as descriptors 3, 4, ... and stdio on /dev/null */
+/* Returns child's pid, or -1 on failure */
+pid_t ProcessRunner::spawn(const std::vector<std::string> &argv,
+			   const std::vector<int>	  &fds)
+{
+	/* Move descriptors clear of 3, 4, ... so that no dup2 in the child
+	   clobbers one still to be moved */
+	std::vector<int> high{};
+	for (int fd : fds) {
+		high.push_back(fcntl(fd, F_DUPFD_CLOEXEC, 64));
+	}
+	std::vector<char *> args{};
+	for (const auto &arg : argv) {
+		args.push_back(const_cast<char *>(arg.c_str()));
+	}
+	args.push_back(nullptr);
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+	posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+	posix_spawn_file_actions_addopen(&actions, 2, "/dev/null", O_WRONLY, 0);
+	bool ok{ !argv.empty() };
+	for (std::size_t i = 0; i < high.size(); i++) {
+		ok = ok && high[i] >= 0;
+		posix_spawn_file_actions_adddup2(&actions, high[i],
+						 static_cast<int>(3 + i));
+	}
+	pid_t pid{ -1 };
+	if (ok && posix_spawnp(&pid, args[0], &actions, nullptr, args.data(),
+			       environ) != 0) {
+		pid = -1;
+	}
+	posix_spawn_file_actions_destroy(&actions);
+	for (int fd : high) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+	return pid;
+}
+
+/* Run 'argv' (looked up on PATH if it has no slash) to completion, passing
+   it 'fds' as descriptors 3, 4, ... (see MemFile) */
+/* Waits for a free slot first. The child is killed if it runs longer than
+   'timeout' (no limit if zero) or the runner is cancelled */
+ProcessResult ProcessRunner::run(const std::vector<std::string> &argv,
+				 std::chrono::milliseconds	 timeout,
+				 const std::vector<int>		&fds)
+{
+	using namespace std::chrono;
+	ProcessResult result{ -1, false, false, 0.0 };
+	auto	      start{ steady_clock::now() };
+	pid_t	      pid{ -1 };
+	{
+		std::unique_lock lock{ mutex_ };
+		slotFree_.wait(lock, [&] {
+			return cancelled_ || active_ < maxChildren_;
+		});
+		if (cancelled_) {
+			result.cancelled = true;
+			return result;
+		}
+		pid = spawn(argv, fds);
+		if (pid < 0) {
+			return result;
+		}
+		active_++;
+		children_.insert(pid);
+	}
+	/* Wait for exit, deadline or cancellation */
+	auto deadline{ start + timeout };
+#ifdef SYS_pidfd_open
+	int pidFd{ static_cast<int>(syscall(SYS_pidfd_open, pid, 0)) };
+#else
+	int pidFd{ -1 };
+#endif
+	int status{ 0 };
+	while (true) {
+		int wait{ -1 };
+		if (timeout.count()) {
+			auto left{ duration_cast<milliseconds>(
+				deadline - steady_clock::now()) };
+			wait = static_cast<int>(std::max<std::int64_t>(
+				left.count(), 0));
+		}
+		if (pidFd < 0) {
+			/* No pidfd, so poll for exit without reaping */
+			wait = wait < 0 ? 10 : std::min(wait, 10);
+			siginfo_t info{};
+			if (waitid(P_PID, static_cast<id_t>(pid), &info,
+				   WEXITED | WNOHANG | WNOWAIT) == 0 &&
+			    info.si_pid == pid) {
+				break;
+			}
+		}
+		pollfd fds[2]{ { cancelFd_, POLLIN, 0 }, { pidFd, POLLIN, 0 } };
+		int    ready{ poll(fds, pidFd < 0 ? 1 : 2, wait) };
+		if (ready < 0 && errno == EINTR) {
+			continue;
+		}
+		if (pidFd >= 0 && fds[1].revents) {
+			break;
+		}
+		bool late{ timeout.count() && steady_clock::now() >= deadline };
+		if (fds[0].revents || late) {
+			result.cancelled = fds[0].revents && !late;
+			result.timedOut	 = late;
+			kill(pid, SIGKILL);
+			break;
+		}
+	}
+	if (pidFd >= 0) {
+		close(pidFd);
+	}
+	/* Forget child before reaping it, after which its pid may be reused
+	   and must not be signalled by cancel() */
+	{
+		std::lock_guard lock{ mutex_ };
+		children_.erase(pid);
+	}
+	waitpid(pid, &status, 0);
+	result.seconds = duration<double>(steady_clock::now() - start).count();
+	/* Free slot */
+	{
+		std::lock_guard lock{ mutex_ };
+		active_--;
+		/* cancel() may have killed child before it was noticed */
+		result.cancelled = result.cancelled ||
+				   (cancelled_ && !WIFEXITED(status));
+	}
+	if (WIFEXITED(status) && !result.timedOut && !result.cancelled) {
+		result.status = WEXITSTATUS(status);
+	}
+	slotFree_.notify_one();
+	return result;
+}
+
+/* Kill running children and refuse new ones until reset() */
+void ProcessRunner::cancel(void) noexcept
+{
+	{
+		std::lock_guard lock{ mutex_ };
+		cancelled_ = true;
+		for (pid_t pid : children_) {
+			kill(pid, SIGKILL);
+		}
+		std::uint64_t one{ 1 };
+		if (cancelFd_ >= 0 && ::write(cancelFd_, &one, sizeof(one)) < 0) {
+			/* Children are killed regardless */
+		}
+	}
+	slotFree_.notify_all();
+}
+
+/* Accept new children again after cancel() */
+void ProcessRunner::reset(void) noexcept
+{
+	std::lock_guard lock{ mutex_ };
+	cancelled_ = false;
+	std::uint64_t count{};
+	if (cancelFd_ >= 0 && ::read(cancelFd_, &count, sizeof(count)) < 0) {
+		/* Not signalled */
+	}
+}
+
+/* Number of children running */
+std::size_t ProcessRunner::running(void) const noexcept
+{
+	std::lock_guard lock{ mutex_ };
+	return children_.size();
+}
+
+/* Whether 'program' can be run, looking it up on PATH if it has no
+   slash */
+bool ProcessRunner::available(const std::string &program)
+{
+	if (program.empty()) {
+		return false;
+	} else if (program.find('/') != std::string::npos) {
+		return access(program.c_str(), X_OK) == 0;
+	}
+	const char	*path{ std::getenv("PATH") };
+	std::string_view dirs{ path ? path : "/usr/bin:/bin" };
+	while (true) {
+		auto	    colon{ dirs.find(':') };
+		std::string dir{ dirs.substr(0, colon) };
+		if (access(((dir.empty() ? "." : dir) + "/" + program).c_str(),
+			   X_OK) == 0) {
+			return true;
+		}
+		if (colon == std::string_view::npos) {
+			return false;
+		}
+		dirs.remove_prefix(colon + 1);
+	}
+}
+
+/* Process-wide runner, bounding children across all solvers */
+ProcessRunner &ProcessRunner::shared(void)
+{
+	static ProcessRunner runner{};
+	return runner;
+}
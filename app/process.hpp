@@ -0,0 +1,81 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/* Anonymous in-memory file (memfd) for passing input to and collecting
+   output from a child process without touching disk */
+/* The child sees the i-th file passed to ProcessRunner::run() as descriptor
+   3 + i, named by childPath(i) */
+class MemFile {
+    public:
+	MemFile(const char *name = "awns") noexcept;
+	~MemFile(void);
+	MemFile(const MemFile &)	    = delete;
+	MemFile &operator=(const MemFile &) = delete;
+
+	bool	    isOpen(void) const noexcept;
+	int	    fd(void) const noexcept;
+	bool	    write(std::string_view);
+	std::string read(void) const;
+
+	static std::string childPath(std::size_t);
+
+    private:
+	int fd_; /* memfd, -1 if not created */
+};
+
+/* Outcome of a child process run by ProcessRunner */
+struct ProcessResult {
+	int    status;	  /* Exit status, -1 if not spawned or killed */
+	bool   timedOut;  /* Killed at its deadline */
+	bool   cancelled; /* Killed by cancel() */
+	double seconds;	  /* Wall time */
+
+	bool ok(void) const noexcept
+	{
+		return status == 0 && !timedOut && !cancelled;
+	}
+};
+
+/* Shell-free runner for external programs such as linkern and the plotting
+   script. Children are started with posix_spawnp(), with stdin, stdout and
+   stderr on /dev/null, and at most a bounded number run at once; callers
+   beyond the bound wait for a slot. Each child is killed if it outlives its
+   deadline or the runner is cancelled */
+class ProcessRunner {
+    public:
+	explicit ProcessRunner(std::size_t maxChildren = 0) noexcept;
+	~ProcessRunner(void);
+	ProcessRunner(const ProcessRunner &)		= delete;
+	ProcessRunner &operator=(const ProcessRunner &) = delete;
+
+	ProcessResult run(const std::vector<std::string> &,
+			  std::chrono::milliseconds,
+			  const std::vector<int> &fds = {});
+	void	      cancel(void) noexcept;
+	void	      reset(void) noexcept;
+	std::size_t   running(void) const noexcept;
+
+	static ProcessRunner &shared(void);
+	static bool	      available(const std::string &);
+
+    private:
+	std::size_t		maxChildren_; /* Bound on concurrent children */
+	std::size_t		active_;      /* Children holding a slot */
+	bool			cancelled_;   /* Flag to mark cancel() called */
+	int			cancelFd_;    /* eventfd signalled by cancel() */
+	std::unordered_set<pid_t> children_;  /* Running children */
+	mutable std::mutex	mutex_;	      /* Guards the above */
+	std::condition_variable slotFree_;    /* Signalled as slots free */
+
+	pid_t spawn(const std::vector<std::string> &, const std::vector<int> &);
+};
@@ -0,0 +1,271 @@
+#include "realtime.hpp"
+
+#include <malloc.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+
+/* Destructor */
+RealtimeProfile::~RealtimeProfile(void)
+{
+	release();
+	if (locked_) {
+		munlockall();
+	}
+}
+
+/* Enable profile, pinning to 'cpu' (see defaultCPU() if none) at SCHED_FIFO
+   'priority' */
+/* Returns false if either is out of range. Nothing is applied until
+   apply() */
+bool RealtimeProfile::configure(std::optional<std::size_t> cpu,
+				int			   priority) noexcept
+{
+	if (cpu && *cpu >= CPU_SETSIZE) {
+		std::cerr << "Error: CPU " << *cpu << " is out of range.\n";
+		return false;
+	}
+	if (priority < sched_get_priority_min(SCHED_FIFO) ||
+	    priority > sched_get_priority_max(SCHED_FIFO)) {
+		std::cerr << "Error: real-time priority " << priority
+			  << " is out of range.\n";
+		return false;
+	}
+	enabled_  = true;
+	cpu_	  = cpu;
+	priority_ = priority;
+	return true;
+}
+
+/* Whether configure() has enabled profile */
+bool RealtimeProfile::enabled(void) const noexcept
+{
+	return enabled_;
+}
+
+/* Whether apply() has run since last release() */
+bool RealtimeProfile::active(void) const noexcept
+{
+	return active_;
+}
+
+/* Apply profile to calling thread */
+/* Each step that fails, usually for want of CAP_SYS_NICE, CAP_IPC_LOCK or
+   RLIMIT_RTPRIO and RLIMIT_MEMLOCK, is reported and skipped. Returns false if
+   any step failed. Threads and processes started afterwards revert to normal
+   scheduling but inherit the affinity, so solve before applying */
+bool RealtimeProfile::apply(void)
+{
+	if (!enabled_ || active_) {
+		return true;
+	}
+	active_ = true;
+	tid_	= gettid();
+	bool ok{ true };
+	std::string applied{};
+	/* Pin to one core */
+	auto cpu{ cpu_ ? cpu_ : defaultCPU() };
+	pinned_ = sched_getaffinity(0, sizeof(saved_), &saved_) == 0;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (cpu) {
+		CPU_SET(*cpu, &set);
+	}
+	if (cpu && pinned_ && sched_setaffinity(0, sizeof(set), &set) == 0) {
+		applied += "CPU " + std::to_string(*cpu) + ", ";
+	} else {
+		std::cerr << "Warning: cannot pin navigation to CPU";
+		if (cpu) {
+			std::cerr << " " << *cpu;
+		}
+		std::cerr << ".\n";
+		pinned_ = false;
+		ok	= false;
+	}
+	/* Fixed-priority scheduling, not inherited by children */
+	sched_param param{};
+	param.sched_priority = priority_;
+	if (sched_setscheduler(0, SCHED_FIFO | SCHED_RESET_ON_FORK, &param) ==
+	    0) {
+		applied += "SCHED_FIFO priority " + std::to_string(priority_) +
+			   ", ";
+	} else {
+		std::cerr << "Warning: cannot schedule navigation SCHED_FIFO: "
+			  << std::strerror(errno) << ".\n";
+		ok = false;
+	}
+	/* Lock and prefault memory, keeping freed heap mapped so later
+	   allocations do not fault either */
+	if (!locked_) {
+		mallopt(M_TRIM_THRESHOLD, -1);
+		mallopt(M_MMAP_MAX, 0);
+		locked_ = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+		if (!locked_) {
+			std::cerr << "Warning: cannot lock memory: "
+				  << std::strerror(errno) << ".\n";
+			ok = false;
+		}
+	}
+	if (locked_) {
+		/* Touch stack the tick path may grow into */
+		volatile unsigned char stack[256 * 1024];
+		for (std::size_t i = 0; i < sizeof(stack); i += 4096) {
+			stack[i] = 0;
+		}
+		applied += "memory locked, ";
+	}
+	if (!applied.empty()) {
+		applied.resize(applied.size() - 2);
+		std::cout << "Real-time profile: " << applied << ".\n";
+	}
+	return ok;
+}
+
+/* Return thread to normal scheduling and its previous affinity, e.g. while
+   solving. Memory stays locked */
+/* Must be called on the thread apply() ran on */
+void RealtimeProfile::release(void) noexcept
+{
+	if (!active_ || gettid() != tid_) {
+		return;
+	}
+	if (pinned_) {
+		sched_setaffinity(0, sizeof(saved_), &saved_);
+		pinned_ = false;
+	}
+	sched_param param{};
+	sched_setscheduler(0, SCHED_OTHER, &param);
+	active_ = false;
+}
+
+/* Core to pin to if none is given: the first core isolated from the
+   scheduler (isolcpus), else the last core this process may run on */
+std::optional<std::size_t> RealtimeProfile::defaultCPU(void)
+{
+	std::ifstream isolated{ "/sys/devices/system/cpu/isolated" };
+	std::size_t   first{};
+	if (isolated >> first && first < CPU_SETSIZE) {
+		return first;
+	}
+	cpu_set_t set;
+	if (sched_getaffinity(0, sizeof(set), &set) < 0) {
+		return std::nullopt;
+	}
+	for (std::size_t cpu = CPU_SETSIZE; cpu-- > 0;) {
+		if (CPU_ISSET(cpu, &set)) {
+			return cpu;
+		}
+	}
+	return std::nullopt;
+}
+
+/* Constructor */
+JitterHistogram::JitterHistogram(void)
+	: counts_(buckets_, 0)
+{
+	reset();
+}
+
+/* Record a tick woken 'late' after its deadline, negative counting as 0 */
+void JitterHistogram::record(std::chrono::nanoseconds late) noexcept
+{
+	auto ns{ static_cast<std::uint64_t>(std::max<std::int64_t>(
+		late.count(), 0)) };
+	counts_[bucket(ns)]++;
+	count_++;
+	min_ = std::min(min_, ns);
+	max_ = std::max(max_, ns);
+	sum_ += static_cast<double>(ns);
+}
+
+/* Discard samples */
+void JitterHistogram::reset(void) noexcept
+{
+	std::fill(counts_.begin(), counts_.end(), 0);
+	count_ = 0;
+	min_   = std::numeric_limits<std::uint64_t>::max();
+	max_   = 0;
+	sum_   = 0.0;
+}
+
+/* Number of samples */
+std::size_t JitterHistogram::count(void) const noexcept
+{
+	return count_;
+}
+
+/* Least sample, 0 if none */
+std::chrono::nanoseconds JitterHistogram::min(void) const noexcept
+{
+	return std::chrono::nanoseconds(count_ ? min_ : 0);
+}
+
+/* Greatest sample, 0 if none */
+std::chrono::nanoseconds JitterHistogram::max(void) const noexcept
+{
+	return std::chrono::nanoseconds(max_);
+}
+
+/* Mean sample, 0 if none */
+std::chrono::nanoseconds JitterHistogram::mean(void) const noexcept
+{
+	return std::chrono::nanoseconds(
+		count_ ? std::llround(sum_ / static_cast<double>(count_)) : 0);
+}
+
+/* Sample at or above 'p' percent of samples, rounded up to its bucket's
+   end */
+std::chrono::nanoseconds JitterHistogram::percentile(double p) const noexcept
+{
+	if (!count_) {
+		return std::chrono::nanoseconds(0);
+	}
+	auto rank{ static_cast<std::size_t>(
+		std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 *
+			  static_cast<double>(count_))) };
+	rank = std::max<std::size_t>(rank, 1);
+	std::size_t seen{ 0 };
+	for (std::size_t i = 0; i < buckets_; i++) {
+		seen += counts_[i];
+		if (seen >= rank) {
+			return std::chrono::nanoseconds(
+				std::clamp(lowerBound(i + 1) - 1, min_, max_));
+		}
+	}
+	return max();
+}
+
+/* Bucket of sample 'ns' */
+std::size_t JitterHistogram::bucket(std::uint64_t ns) noexcept
+{
+	if (ns < (1U << subBits_)) {
+		return ns;
+	}
+	unsigned shift{ static_cast<unsigned>(std::bit_width(ns)) - subBits_ -
+			1 };
+	return (static_cast<std::size_t>(shift) << subBits_) + (ns >> shift);
+}
+
+/* Least sample in bucket 'i' */
+std::uint64_t JitterHistogram::lowerBound(std::size_t i) noexcept
+{
+	if (i < (2U << subBits_)) {
+		return i;
+	}
+	unsigned shift{ static_cast<unsigned>(i >> subBits_) - 1 };
+	return ((i & ((1U << subBits_) - 1)) + (1U << subBits_)) << shift;
+}
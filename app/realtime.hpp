@@ -0,0 +1,78 @@
+#pragma once
+
+#include <sched.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/* Real-time execution profile for the thread calling apply(). The thread is
+   pinned to one core, scheduled SCHED_FIFO and all memory is locked and
+   prefaulted, so that page faults and time-sharing do not delay its ticks */
+class RealtimeProfile {
+    public:
+	static constexpr int defaultPriority{ 49 }; /* Just below threaded
+						       interrupt handlers */
+
+	RealtimeProfile(void) noexcept = default;
+	~RealtimeProfile(void);
+	RealtimeProfile(const RealtimeProfile &)	    = delete;
+	RealtimeProfile &operator=(const RealtimeProfile &) = delete;
+
+	bool configure(std::optional<std::size_t>, int) noexcept;
+	bool enabled(void) const noexcept;
+	bool active(void) const noexcept;
+	bool apply(void);
+	void release(void) noexcept;
+
+	static std::optional<std::size_t> defaultCPU(void);
+
+    private:
+	bool			   enabled_{ false };  /* Whether configured */
+	bool			   active_{ false };   /* Whether applied */
+	bool			   locked_{ false };   /* Whether memory is
+							  locked */
+	std::optional<std::size_t> cpu_{};	       /* Core to pin to, or
+							  default */
+	int			   priority_{ defaultPriority }; /* FIFO
+								    priority */
+	bool			   pinned_{ false };   /* Whether saved_ holds
+							  previous affinity */
+	cpu_set_t		   saved_{};	       /* Affinity before
+							  apply() */
+	pid_t			   tid_{ 0 };	       /* Thread applied to */
+};
+
+/* Histogram of tick wake-up lateness, recorded without allocating so it is
+   safe on the real-time path. Buckets are exact below 128 ns and then 64 per
+   power of two, so percentiles are within 1.6% */
+class JitterHistogram {
+    public:
+	JitterHistogram(void);
+
+	void record(std::chrono::nanoseconds) noexcept;
+	void reset(void) noexcept;
+
+	std::size_t		 count(void) const noexcept;
+	std::chrono::nanoseconds min(void) const noexcept;
+	std::chrono::nanoseconds max(void) const noexcept;
+	std::chrono::nanoseconds mean(void) const noexcept;
+	std::chrono::nanoseconds percentile(double) const noexcept;
+
+    private:
+	static constexpr unsigned    subBits_{ 6 }; /* log2 of buckets per
+						       power of two */
+	static constexpr std::size_t buckets_{ (64 - subBits_ + 1)
+					       << subBits_ };
+
+	std::vector<std::uint64_t> counts_; /* Samples per bucket */
+	std::size_t		   count_;  /* Samples recorded */
+	std::uint64_t		   min_;    /* Least sample in ns */
+	std::uint64_t		   max_;    /* Greatest sample in ns */
+	double			   sum_;    /* Sum of samples in ns */
+
+	static std::size_t   bucket(std::uint64_t) noexcept;
+	static std::uint64_t lowerBound(std::size_t) noexcept;
+};
@@ -0,0 +1,133 @@
+#include "route.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+/* Build table for closed 'tour' of {latitude, longitude} in degrees */
+void LegTable::build(const std::vector<std::pair<double, double> > &tour)
+{
+	constexpr double degToRad = std::numbers::pi / 180.0;
+	std::size_t	 n{ tour.size() };
+	legs_.resize(n);
+	cumulative_.assign(n + 1, 0.0);
+	for (std::size_t i = 0; i < n; i++) {
+		const auto &a{ tour[i] };
+		const auto &b{ tour[(i + 1) % n] };
+		double	    φ1 = a.first * degToRad;
+		double	    φ2 = b.first * degToRad;
+		double	    Δλ = (b.second - a.second) * degToRad;
+		/* Forward azimuth */
+		double y = std::sin(Δλ) * std::cos(φ2);
+		double x = std::cos(φ1) * std::sin(φ2) -
+			   std::sin(φ1) * std::cos(φ2) * std::cos(Δλ);
+		legs_[i] = { distance(a, b), std::atan2(y, x), φ1,
+			     a.second * degToRad, std::cos(φ1) };
+		cumulative_[i + 1] = cumulative_[i] + legs_[i].length;
+	}
+}
+
+/* Load table built earlier, e.g. from a mission bundle */
+/* 'cumulative' must have one more entry than 'legs' */
+void LegTable::load(std::span<const Leg>    legs,
+		    std::span<const double> cumulative)
+{
+	legs_.assign(legs.begin(), legs.end());
+	cumulative_.assign(cumulative.begin(), cumulative.end());
+}
+
+/* Legs in tour order, for saving table */
+std::span<const LegTable::Leg> LegTable::legs(void) const noexcept
+{
+	return legs_;
+}
+
+/* Prefix sums of leg lengths, for saving table */
+std::span<const double> LegTable::cumulative(void) const noexcept
+{
+	return cumulative_;
+}
+
+/* Whether table has been built */
+bool LegTable::empty(void) const noexcept
+{
+	return legs_.empty();
+}
+
+/* Total tour length in meters */
+double LegTable::total(void) const noexcept
+{
+	return cumulative_.empty() ? 0.0 : cumulative_.back();
+}
+
+/* Length of leg 'i' in meters */
+double LegTable::length(std::size_t i) const noexcept
+{
+	return legs_[i].length;
+}
+
+/* Initial bearing of leg 'i' in degrees from true North in [0,360) */
+double LegTable::bearing(std::size_t i) const noexcept
+{
+	double deg{ legs_[i].bearing * 180.0 / std::numbers::pi };
+	return deg < 0.0 ? deg + 360.0 : deg;
+}
+
+/* Distance along tour from its start to waypoint 'i' in meters, 'i' = N being
+   the return to the start */
+double LegTable::cumulative(std::size_t i) const noexcept
+{
+	return cumulative_[i];
+}
+
+/* Distance left in meters when heading to waypoint 'dest', 'toDest' meters
+   away; destination 0 is the return to the start, so only 'toDest' remains */
+double LegTable::remaining(std::size_t dest, double toDest) const noexcept
+{
+	std::size_t pos{ dest ? dest : legs_.size() };
+	return toDest + total() - cumulative_[pos];
+}
+
+/* Cross-track distance in meters of '{latitude, longitude}' from the great
+   circle of leg 'i', positive to the right of track */
+double LegTable::crossTrack(std::size_t			     i,
+			    const std::pair<double, double> &p) const noexcept
+{
+	constexpr double degToRad = std::numbers::pi / 180.0;
+	const Leg	&leg{ legs_[i] };
+	double		 φ3 = p.first * degToRad;
+	double		 Δλ = p.second * degToRad - leg.λ1;
+	double		 cosφ3{ std::cos(φ3) };
+	/* Angular distance and bearing from leg start to point */
+	double sinDφ2 = std::sin((φ3 - leg.φ1) / 2);
+	double sinDλ2 = std::sin(Δλ / 2);
+	double h      = std::clamp(sinDφ2 * sinDφ2 +
+					   leg.cosφ1 * cosφ3 * sinDλ2 * sinDλ2,
+			      0.0, 1.0);
+	double δ13    = 2 * std::atan2(std::sqrt(h), std::sqrt(1 - h));
+	double θ13    = std::atan2(std::sin(Δλ) * cosφ3,
+				   leg.cosφ1 * std::sin(φ3) -
+					   std::sin(leg.φ1) * cosφ3 *
+						   std::cos(Δλ));
+	return std::asin(std::sin(δ13) * std::sin(θ13 - leg.bearing)) *
+	       earthRadius_;
+}
+
+/* Haversine distance in meters between two {latitude, longitude} in
+   degrees */
+double LegTable::distance(const std::pair<double, double> &a,
+			  const std::pair<double, double> &b) noexcept
+{
+	constexpr double degToRad = std::numbers::pi / 180.0;
+	double		 φ1	  = a.first * degToRad;
+	double		 φ2	  = b.first * degToRad;
+	double		 sinDφ2	  = std::sin((φ2 - φ1) / 2);
+	double		 sinDλ2	  = std::sin((b.second - a.second) * degToRad / 2);
+	double h = std::clamp(sinDφ2 * sinDφ2 +
+				      std::cos(φ1) * std::cos(φ2) * sinDλ2 * sinDλ2,
+			      0.0, 1.0);
+	return 2 * earthRadius_ * std::atan2(std::sqrt(h), std::sqrt(1 - h));
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+/* Mission progress against the route, see Navigator::getProgress() */
+struct RouteProgress {
+	double percent;	   /* Percent of tour length completed */
+	double remaining;  /* Distance left in meters */
+	double crossTrack; /* Offset from current leg in meters, positive to
+			      the right of track */
+	double eta;	   /* Seconds to completion at current speed, negative
+			      if speed unknown */
+};
+
+/* Per-leg table of a closed tour built once per mission, so progress,
+   remaining distance and cross-track error cost O(1) per tick. Leg i runs
+   from tour[i] to tour[(i + 1) % N] */
+class LegTable {
+    public:
+	/* Precomputed terms of a leg */
+	struct Leg {
+		double length;	/* Great-circle length in meters */
+		double bearing; /* Initial bearing in radians from true North */
+		double φ1;	/* Latitude of start in radians */
+		double λ1;	/* Longitude of start in radians */
+		double cosφ1;	/* Cosine of start latitude */
+	};
+
+	void   build(const std::vector<std::pair<double, double> > &);
+	void   load(std::span<const Leg>, std::span<const double>);
+	bool   empty(void) const noexcept;
+	double total(void) const noexcept;
+	double length(std::size_t) const noexcept;
+	double bearing(std::size_t) const noexcept;
+	double cumulative(std::size_t) const noexcept;
+	double remaining(std::size_t, double) const noexcept;
+	double crossTrack(std::size_t, const std::pair<double, double> &) const
+		noexcept;
+
+	std::span<const Leg>	legs(void) const noexcept;
+	std::span<const double> cumulative(void) const noexcept;
+
+	static double distance(const std::pair<double, double> &,
+			       const std::pair<double, double> &) noexcept;
+
+    private:
+	static constexpr double earthRadius_{
+		6371000.0
+	}; /* Earth's radius in meters */
+	std::vector<Leg>    legs_;	  /* Legs in tour order */
+	std::vector<double> cumulative_; /* Prefix sums of leg lengths, N + 1
+					    entries */
+};
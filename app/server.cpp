@@ -0,0 +1,198 @@
+#include "server.hpp"
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* Destructor */
+MissionServer::~MissionServer(void)
+{
+	close();
+}
+
+/* Listen on Unix domain socket 'path', replacing any stale socket file */
+/* Returns false if the socket could not be created */
+bool MissionServer::open(const std::string &path)
+{
+	close();
+	sockaddr_un addr{};
+	if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+		std::cerr << "Error: server socket path '" << path
+			  << "' not valid.\n";
+		return false;
+	}
+	addr.sun_family = AF_UNIX;
+	std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+	listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+			   0);
+	if (listenFd_ < 0) {
+		std::cerr << "Error: cannot create server socket.\n";
+		return false;
+	}
+	/* Replace a stale socket, but never another kind of file */
+	struct stat st {};
+	if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+		unlink(path.c_str());
+	}
+	if (bind(listenFd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) <
+		    0 ||
+	    listen(listenFd_, 16) < 0) {
+		std::cerr << "Error: cannot listen on server socket '" << path
+			  << "'.\n";
+		::close(listenFd_);
+		listenFd_ = -1;
+		return false;
+	}
+	path_ = path;
+	/* Watch listener and clients in one descriptor for fd() */
+	epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+	epoll_event event{ EPOLLIN, { .fd = listenFd_ } };
+	if (epollFd_ < 0 ||
+	    epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd_, &event) < 0) {
+		std::cerr << "Error: cannot watch server socket '" << path
+			  << "'.\n";
+		close();
+		return false;
+	}
+	return true;
+}
+
+/* Disconnect clients and remove socket, if open */
+void MissionServer::close(void) noexcept
+{
+	for (auto &client : clients_) {
+		::close(client.fd);
+	}
+	clients_.clear();
+	if (listenFd_ >= 0) {
+		::close(listenFd_);
+		unlink(path_.c_str());
+		listenFd_ = -1;
+	}
+	if (epollFd_ >= 0) {
+		::close(epollFd_);
+		epollFd_ = -1;
+	}
+}
+
+/* Wait up to 'timeoutMs' milliseconds (forever if negative) for activity,
+   then accept new clients and return every complete request received */
+std::vector<ServerRequest> MissionServer::poll(int timeoutMs)
+{
+	std::vector<ServerRequest> requests{};
+	std::vector<pollfd>	   fds{ { listenFd_, POLLIN, 0 } };
+	for (const auto &client : clients_) {
+		fds.push_back({ client.fd, POLLIN, 0 });
+	}
+	if (::poll(fds.data(), fds.size(), timeoutMs) <= 0) {
+		return requests;
+	}
+	/* Read from clients, dropping those that hung up */
+	for (std::size_t i = 1; i < fds.size(); i++) {
+		if (!fds[i].revents) {
+			continue;
+		}
+		auto &client{ clients_[i - 1] };
+		char  chunk[4096];
+		/* Read at most bufferLimit_ ahead, leaving the rest queued in
+		   the socket until requests are taken */
+		while (client.buffer.size() < bufferLimit_) {
+			ssize_t n{ recv(client.fd, chunk, sizeof(chunk),
+					MSG_DONTWAIT) };
+			if (n > 0) {
+				client.buffer.append(chunk,
+						     static_cast<std::size_t>(n));
+				continue;
+			}
+			if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK &&
+				       errno != EINTR)) {
+				::close(client.fd);
+				client.fd = -1;
+			}
+			break;
+		}
+		/* Drop a client whose request line outgrows the buffer */
+		if (client.fd >= 0 && client.buffer.size() >= bufferLimit_ &&
+		    client.buffer.find('\n') == std::string::npos) {
+			std::cerr << "Error: dropped serve client sending a "
+				     "request over "
+				  << bufferLimit_ << " bytes.\n";
+			::close(client.fd);
+			client.fd = -1;
+			client.buffer.clear();
+		}
+		/* Split complete lines into requests */
+		for (auto nl{ client.buffer.find('\n') };
+		     nl != std::string::npos; nl = client.buffer.find('\n')) {
+			std::string line{ client.buffer.substr(0, nl) };
+			client.buffer.erase(0, nl + 1);
+			if (line.find_first_not_of(" \t\r") == std::string::npos) {
+				continue;
+			}
+			json body = json::parse(line, nullptr, false);
+			requests.push_back({ client.fd,
+					     body.is_discarded() ? json{} :
+								   body });
+		}
+	}
+	std::erase_if(clients_,
+		      [](const Client &client) { return client.fd < 0; });
+	/* Accept new clients */
+	if (fds[0].revents) {
+		while (true) {
+			int fd{ accept4(listenFd_, nullptr, nullptr,
+					SOCK_NONBLOCK | SOCK_CLOEXEC) };
+			if (fd < 0) {
+				break;
+			}
+			epoll_event event{ EPOLLIN, { .fd = fd } };
+			epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event);
+			clients_.push_back({ fd, {} });
+		}
+	}
+	return requests;
+}
+
+/* Send 'body' as one line to 'client', if still connected */
+void MissionServer::reply(int client, const json &body)
+{
+	if (client < 0) {
+		return;
+	}
+	std::string line{ body.dump() + "\n" };
+	std::size_t sent{ 0 };
+	while (sent < line.size()) {
+		ssize_t n{ send(client, line.data() + sent, line.size() - sent,
+				MSG_NOSIGNAL) };
+		if (n < 0 && errno == EAGAIN) {
+			/* Replies are small, so wait briefly for room */
+			pollfd pfd{ client, POLLOUT, 0 };
+			if (::poll(&pfd, 1, 100) <= 0) {
+				return;
+			}
+			continue;
+		}
+		if (n < 0 && errno != EINTR) {
+			return;
+		}
+		sent += n > 0 ? static_cast<std::size_t>(n) : 0;
+	}
+}
+
+/* Descriptor readable while a client connects or sends, to wait on together
+   with other descriptors and then take requests with poll(). Closed clients
+   leave it on their own */
+int MissionServer::fd(void) const noexcept
+{
+	return epollFd_;
+}
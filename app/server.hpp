@@ -0,0 +1,50 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+/* Request received by MissionServer, answered with reply() */
+struct ServerRequest {
+	int  client; /* Connection to reply on */
+	json body;   /* Parsed request, null if malformed */
+};
+
+/* Line-delimited JSON request server on a Unix domain stream socket, used by
+   the 'serve' command. Each line a client sends is one request, and each
+   reply is one line. At most bufferLimit_ bytes are buffered per client,
+   and a client sending a longer line is dropped */
+class MissionServer {
+    public:
+	MissionServer(void) noexcept = default;
+	~MissionServer(void);
+	MissionServer(const MissionServer &)		= delete;
+	MissionServer &operator=(const MissionServer &) = delete;
+
+	bool			   open(const std::string &);
+	void			   close(void) noexcept;
+	std::vector<ServerRequest> poll(int);
+	void			   reply(int, const json &);
+	int			   fd(void) const noexcept;
+
+    private:
+	/* Connected client and bytes received short of a full line */
+	struct Client {
+		int	    fd;
+		std::string buffer;
+	};
+
+	static constexpr std::size_t bufferLimit_{ 64 * 1024 }; /* Bytes
+								   buffered
+								   per client */
+
+	int		    listenFd_{ -1 }; /* Listening socket */
+	int		    epollFd_{ -1 };  /* Readable while listener or a
+						client is */
+	std::string	    path_;	     /* Socket path */
+	std::vector<Client> clients_;	     /* Connected clients */
+};
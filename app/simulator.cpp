@@ -0,0 +1,225 @@
+#include "simulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "gps.hpp"
+#include "navigator.hpp"
+#include "policy.hpp"
+#include "route.hpp"
+
+/* Constructor */
+SyntheticGPS::SyntheticGPS(const std::pair<double, double> &start) noexcept
+	: pos_{ start },
+	  heading_{ 0.0 },
+	  speed_{ 0.0 },
+	  sigma_{ 0.0 },
+	  tau_{ 0.0 },
+	  lastRead_{ -1.0 },
+	  error_{ 0.0, 0.0 },
+	  rng_{ 0 },
+	  normal_{ 0.0, 1.0 }
+{
+}
+
+/* Whether fixes can be read, always */
+bool SyntheticGPS::connect(void) const noexcept
+{
+	return true;
+}
+
+/* No stream to start */
+void SyntheticGPS::startStream(void) noexcept
+{
+}
+
+/* No stream to stop */
+void SyntheticGPS::stopStream(void) noexcept
+{
+}
+
+/* Report vehicle's position at current ReplayClock time, see read() */
+std::optional<GPSFix> SyntheticGPS::waitReadFix(void) noexcept
+{
+	return pollFix();
+}
+
+/* Report vehicle's position at current ReplayClock time, see read() */
+/* A fix is always available, as the vehicle is simulated on demand */
+std::optional<GPSFix> SyntheticGPS::pollFix(void) noexcept
+{
+	return read(std::chrono::duration<double>(
+			    ReplayClock::now().time_since_epoch())
+			    .count());
+}
+
+/* Fixes are read on demand without waiting, so there is no wait to wake */
+void SyntheticGPS::setWakeFd(int) noexcept
+{
+}
+
+bool SyntheticGPS::woken(void) const noexcept
+{
+	return false;
+}
+
+/* Setter for position noise with standard deviation 'sigma' meters,
+   correlation time 'tau' seconds (0 for white noise) and generator 'seed' */
+void SyntheticGPS::setNoise(double sigma, double tau,
+			    std::uint64_t seed) noexcept
+{
+	sigma_	  = std::max(sigma, 0.0);
+	tau_	  = std::max(tau, 0.0);
+	lastRead_ = -1.0;
+	error_	  = { 0.0, 0.0 };
+	rng_.seed(seed);
+	normal_.reset();
+}
+
+/* Report vehicle's position as a fix taken at 'time' seconds */
+/* Noisy fixes report their 95% error estimate like gpsd; noiseless fixes
+   report none, so filtering uses its default */
+GPSFix SyntheticGPS::read(double time) noexcept
+{
+	constexpr double nan{ std::numeric_limits<double>::quiet_NaN() };
+	if (!sigma_) {
+		return GPSFix{ pos_.first, pos_.second, heading_, speed_, time,
+			       nan,	   nan };
+	}
+	/* Draw from stationary distribution on first read, else step the
+	   Gauss-Markov process by the time since last read */
+	double φ{ 0.0 };
+	if (lastRead_ >= 0.0 && tau_ > 0.0) {
+		φ = std::exp(-(time - lastRead_) / tau_);
+	}
+	double w{ sigma_ * std::sqrt(1.0 - φ * φ) };
+	error_.first  = φ * error_.first + w * normal_(rng_);
+	error_.second = φ * error_.second + w * normal_(rng_);
+	lastRead_     = time;
+	/* Convert error to degrees at vehicle's latitude */
+	constexpr double degToRad = std::numbers::pi / 180.0;
+	double		 ky	  = earthRadius_ * degToRad;
+	double kx = ky * std::max(std::cos(pos_.first * degToRad), 1.0e-6);
+	return GPSFix{ pos_.first + error_.second / ky,
+		       pos_.second + error_.first / kx,
+		       heading_,
+		       speed_,
+		       time,
+		       1.96 * sigma_,
+		       1.96 * sigma_ };
+}
+
+/* Drive vehicle at 'speed' meters per second along 'bearing' degrees from
+   true North for 'dt' seconds, along a great circle. Returns distance driven
+   in meters */
+double SyntheticGPS::drive(double bearing, double speed, double dt) noexcept
+{
+	constexpr double degToRad = std::numbers::pi / 180.0;
+	double		 dist	  = speed * dt;
+	double		 δ	  = dist / earthRadius_;
+	double		 θ	  = bearing * degToRad;
+	double		 φ1	  = pos_.first * degToRad;
+	double		 λ1	  = pos_.second * degToRad;
+	double		 φ2	  = std::asin(std::sin(φ1) * std::cos(δ) +
+					      std::cos(φ1) * std::sin(δ) * std::cos(θ));
+	double λ2 = λ1 + std::atan2(std::sin(θ) * std::sin(δ) * std::cos(φ1),
+				    std::cos(δ) - std::sin(φ1) * std::sin(φ2));
+	pos_.first  = φ2 / degToRad;
+	pos_.second = std::fmod(λ2 / degToRad + 540.0, 360.0) - 180.0;
+	heading_    = bearing;
+	speed_	    = speed;
+	return dist;
+}
+
+/* Getter for pos_ */
+const std::pair<double, double> &SyntheticGPS::position(void) const noexcept
+{
+	return pos_;
+}
+
+/* Constructor */
+/* 'nav' must already hold a tour, see BasicNavigator::loadTour() */
+Simulator::Simulator(ReplayNavigator &nav, SyntheticGPS &gps) noexcept
+	: nav_{ nav },
+	  gps_{ gps },
+	  velocity_{ 1.0 },
+	  tick_{ 1.0 },
+	  timeLimit_{ 0.0 }
+{
+}
+
+/* Setter for vehicle speed in meters per second, must be positive */
+void Simulator::setVelocity(double v) noexcept
+{
+	velocity_ = std::max(v, 1.0e-3);
+}
+
+/* Setter for seconds between navigation ticks, must be positive */
+void Simulator::setTick(double dt) noexcept
+{
+	tick_ = std::max(dt, 1.0e-6);
+}
+
+/* Setter for mission time limit in seconds */
+/* If not set or set to 0 (the default), the limit is ten times the time to
+   drive the tour plus a minute */
+void Simulator::setTimeLimit(double t) noexcept
+{
+	timeLimit_ = std::max(t, 0.0);
+}
+
+/* Great-circle length in meters of a closed tour */
+double Simulator::tourLength(const std::vector<std::pair<double, double> > &tour)
+{
+	LegTable legs{};
+	legs.build(tour);
+	return legs.total();
+}
+
+/* Run mission until tour completes or time limit expires */
+/* Each tick the navigator steers from the synthetic fix, arrivals are
+   recorded against ReplayClock, restarted at 0, and the vehicle drives one
+   tick along the commanded bearing */
+MissionReport Simulator::run(void)
+{
+	using namespace std::chrono;
+	auto now{ [] {
+		return duration<double>(ReplayClock::now().time_since_epoch())
+			.count();
+	} };
+	auto tick{ duration_cast<ReplayClock::duration>(
+		duration<double>(tick_)) };
+	ReplayClock::reset();
+	const auto &order{ nav_.getTourOrder() };
+	double	    length{ tourLength(nav_.getTour()) };
+	double	    limit{ timeLimit_ ? timeLimit_ :
+					10.0 * length / velocity_ + 60.0 };
+	MissionReport report{ false, 0.0, length, 0.0, 0, {} };
+	report.arrivals.reserve(order.size());
+	std::size_t prev{ nav_.getNextDest() };
+	while (now() <= limit) {
+		auto bearing{ nav_.steer(*gps_.pollFix()) };
+		report.ticks++;
+		/* Tour completed on arrival back at the starting position */
+		if (!bearing) {
+			report.arrivals.emplace_back(order[prev], now());
+			report.completed = true;
+			break;
+		}
+		/* Record arrival if destination advanced */
+		if (std::size_t next{ nav_.getNextDest() }; next != prev) {
+			report.arrivals.emplace_back(order[prev], now());
+			prev = next;
+		}
+		report.distance += gps_.drive(*bearing, velocity_, tick_);
+		ReplayClock::sleepUntil(ReplayClock::now() + tick);
+	}
+	report.time = now();
+	return report;
+}
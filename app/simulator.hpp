@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gps.hpp"
+#include "navigator.hpp"
+#include "policy.hpp"
+
+/* Synthetic position source standing in for GPSClient, reporting the
+   position of a simulated vehicle that drives along commanded bearings, at
+   the time of ReplayClock */
+/* Reported positions carry optional noise: a first-order Gauss-Markov error
+   per axis with standard deviation sigma and correlation time tau, which is
+   white noise when tau is 0 */
+class SyntheticGPS {
+    public:
+	SyntheticGPS(const std::pair<double, double> &start) noexcept;
+
+	bool		      connect(void) const noexcept;
+	void		      startStream(void) noexcept;
+	void		      stopStream(void) noexcept;
+	std::optional<GPSFix> waitReadFix(void) noexcept;
+	std::optional<GPSFix> pollFix(void) noexcept;
+	void		      setWakeFd(int) noexcept;
+	bool		      woken(void) const noexcept;
+
+	void   setNoise(double, double, std::uint64_t) noexcept;
+	GPSFix read(double) noexcept;
+	double drive(double, double, double) noexcept;
+	const std::pair<double, double> &position(void) const noexcept;
+
+    private:
+	static constexpr double earthRadius_{
+		6371000.0
+	}; /* Earth's radius in meters */
+	std::pair<double, double> pos_;	     /* True lat, lon of vehicle */
+	double			  heading_;  /* Heading from true North */
+	double			  speed_;    /* Speed in meters per second */
+	double			  sigma_;    /* Noise standard deviation in
+						meters */
+	double			  tau_;	     /* Noise correlation time in
+						seconds */
+	double			  lastRead_; /* Time of last read, negative
+						before first */
+	std::pair<double, double> error_;    /* East, north error in meters */
+	std::mt19937_64		  rng_;	     /* Noise generator */
+	std::normal_distribution<double> normal_; /* Standard normal */
+};
+
+static_assert(PositionSource<SyntheticGPS>);
+
+/* Result of a simulated mission */
+struct MissionReport {
+	bool	    completed;	/* Whether tour completed within time limit */
+	double	    distance;	/* Distance driven in meters */
+	double	    tourLength; /* Great-circle length of tour in meters */
+	double	    time;	/* Mission time in seconds */
+	std::size_t ticks;	/* Navigation ticks taken */
+	std::vector<std::pair<std::size_t, double> >
+		arrivals; /* Waypoint (CSV index) and arrival time in seconds */
+};
+
+/* Offline mission simulator driving a Navigator with a synthetic position
+   source on ReplayClock, as fast as the CPU allows. The clock is per
+   thread, so simulations on worker threads do not interfere */
+class Simulator {
+    public:
+	Simulator(ReplayNavigator &, SyntheticGPS &) noexcept;
+
+	void	      setVelocity(double) noexcept;
+	void	      setTick(double) noexcept;
+	void	      setTimeLimit(double) noexcept;
+	MissionReport run(void);
+
+	static double tourLength(const std::vector<std::pair<double, double> > &);
+
+    private:
+	ReplayNavigator &nav_;	     /* Navigator under simulation */
+	SyntheticGPS	&gps_;	     /* Injected position source */
+	double		 velocity_;  /* Vehicle speed in meters per second */
+	double		 tick_;	     /* Seconds between navigation ticks */
+	double		 timeLimit_; /* Mission time limit in seconds, 0 for
+				     automatic */
+};
@@ -0,0 +1,239 @@
+#include "stream.hpp"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/* Helper to append 'value' to 'out' in little-endian byte order */
+template <typename T> static void putLE(std::vector<std::uint8_t> &out, T value)
+{
+	std::uint64_t bits{};
+	if constexpr (std::is_floating_point_v<T>) {
+		bits = std::bit_cast<std::uint64_t>(value);
+	} else {
+		bits = static_cast<std::uint64_t>(value);
+	}
+	for (std::size_t i = 0; i < sizeof(T); i++) {
+		out.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+	}
+}
+
+/* Helper to read 'T' in little-endian byte order from 'in' */
+template <typename T> static T getLE(const std::uint8_t *in) noexcept
+{
+	std::uint64_t bits{ 0 };
+	for (std::size_t i = 0; i < sizeof(T); i++) {
+		bits |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+	}
+	if constexpr (sizeof(T) == 8) {
+		return std::bit_cast<T>(bits);
+	} else {
+		return static_cast<T>(bits);
+	}
+}
+
+/* Encode 'command' as a fixed-size little-endian binary frame */
+std::vector<std::uint8_t> CommandStream::encode(const NavCommand &command)
+{
+	std::vector<std::uint8_t> frame{};
+	frame.reserve(binaryFrameSize);
+	putLE(frame, command.bearing);
+	putLE(frame, command.latitude);
+	putLE(frame, command.longitude);
+	putLE(frame, command.destLatitude);
+	putLE(frame, command.destLongitude);
+	putLE(frame, command.distance);
+	putLE(frame, command.crossTrack);
+	putLE(frame, command.percent);
+	putLE(frame, command.waypoint);
+	putLE(frame, command.timestamp);
+	putLE(frame, command.completed);
+	putLE(frame, command.status);
+	return frame;
+}
+
+/* Decode binary frame of binaryFrameSize bytes at 'in' */
+NavCommand CommandStream::decode(const std::uint8_t *in) noexcept
+{
+	return { getLE<double>(in),
+		 getLE<double>(in + 8),
+		 getLE<double>(in + 16),
+		 getLE<double>(in + 24),
+		 getLE<double>(in + 32),
+		 getLE<double>(in + 40),
+		 getLE<double>(in + 48),
+		 getLE<double>(in + 56),
+		 getLE<std::uint64_t>(in + 64),
+		 getLE<std::int64_t>(in + 72),
+		 getLE<std::uint32_t>(in + 80),
+		 getLE<std::uint32_t>(in + 84) };
+}
+
+/* Destructor */
+CommandStream::~CommandStream(void)
+{
+	close();
+}
+
+/* Listen on Unix domain socket 'path', replacing any stale socket file */
+/* Returns false if the socket could not be created */
+bool CommandStream::open(const std::string &path, StreamFormat format)
+{
+	close();
+	sockaddr_un addr{};
+	if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+		std::cerr << "Error: command stream path '" << path
+			  << "' not valid.\n";
+		return false;
+	}
+	addr.sun_family = AF_UNIX;
+	std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+	listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+			   0);
+	if (listenFd_ < 0) {
+		std::cerr << "Error: cannot create command stream socket.\n";
+		return false;
+	}
+	/* Replace a stale socket, but never another kind of file */
+	struct stat st {};
+	if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+		unlink(path.c_str());
+	}
+	if (bind(listenFd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) <
+		    0 ||
+	    listen(listenFd_, 16) < 0) {
+		std::cerr << "Error: cannot listen on command stream '" << path
+			  << "'.\n";
+		::close(listenFd_);
+		listenFd_ = -1;
+		return false;
+	}
+	path_	= path;
+	format_ = format;
+	return true;
+}
+
+/* Disconnect subscribers and remove socket, if open */
+void CommandStream::close(void) noexcept
+{
+	for (auto &client : clients_) {
+		::close(client.fd);
+	}
+	clients_.clear();
+	if (listenFd_ >= 0) {
+		::close(listenFd_);
+		unlink(path_.c_str());
+		listenFd_ = -1;
+	}
+}
+
+/* Whether stream is open */
+bool CommandStream::isOpen(void) const noexcept
+{
+	return listenFd_ >= 0;
+}
+
+/* Setter for bytes that may be queued per subscriber, at least one frame */
+void CommandStream::setBacklogLimit(std::size_t bytes) noexcept
+{
+	backlogLimit_ = std::max(bytes, binaryFrameSize);
+}
+
+/* Number of connected subscribers */
+std::size_t CommandStream::subscribers(void) const noexcept
+{
+	return clients_.size();
+}
+
+/* Number of frames missed by slow subscribers */
+std::uint64_t CommandStream::dropped(void) const noexcept
+{
+	return dropped_;
+}
+
+/* Accept every pending subscriber without blocking */
+void CommandStream::acceptClients(void)
+{
+	while (true) {
+		int fd{ accept4(listenFd_, nullptr, nullptr,
+				SOCK_NONBLOCK | SOCK_CLOEXEC) };
+		if (fd < 0) {
+			return;
+		}
+		clients_.push_back({ fd, {} });
+	}
+}
+
+/* Send as much of 'client''s backlog as the socket takes without blocking */
+/* Returns false if the subscriber hung up or errored */
+bool CommandStream::flush(Client &client)
+{
+	std::size_t sent{ 0 };
+	while (sent < client.pending.size()) {
+		ssize_t n{ send(client.fd, client.pending.data() + sent,
+				client.pending.size() - sent,
+				MSG_DONTWAIT | MSG_NOSIGNAL) };
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				return false;
+			}
+			break;
+		}
+		sent += static_cast<std::size_t>(n);
+	}
+	client.pending.erase(client.pending.begin(),
+			     client.pending.begin() + sent);
+	return true;
+}
+
+/* Publish one tick's 'command', or its navigation 'output' in CBOR format,
+   to every subscriber */
+void CommandStream::publish(const NavCommand &command, const json &output)
+{
+	acceptClients();
+	if (clients_.empty()) {
+		return;
+	}
+	/* Encode frame once for all subscribers */
+	std::vector<std::uint8_t> frame{};
+	if (format_ == StreamFormat::binary) {
+		frame = encode(command);
+	} else {
+		auto body{ json::to_cbor(output) };
+		putLE(frame, static_cast<std::uint32_t>(body.size()));
+		frame.insert(frame.end(), body.begin(), body.end());
+	}
+	/* Queue whole frames only, so a slow subscriber skips frames but never
+	   sees a partial one */
+	for (auto &client : clients_) {
+		if (!client.pending.empty() &&
+		    client.pending.size() + frame.size() > backlogLimit_) {
+			dropped_++;
+			continue;
+		}
+		client.pending.insert(client.pending.end(), frame.begin(),
+				      frame.end());
+	}
+	/* Drop subscribers that hung up */
+	std::erase_if(clients_, [this](Client &client) {
+		if (flush(client)) {
+			return false;
+		}
+		::close(client.fd);
+		return true;
+	});
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "command.hpp"
+
+using json = nlohmann::json;
+
+/* Wire format of a command stream */
+enum class StreamFormat {
+	binary, /* Fixed-size little-endian NavCommand frames */
+	cbor	/* Navigation output as CBOR, prefixed by 32-bit little-endian
+		   length */
+};
+
+/* Non-blocking publisher of navigation commands to any number of
+   subscribers on a Unix domain stream socket. Frames are encoded once per
+   tick and queued per subscriber; a subscriber whose backlog would exceed
+   the limit misses whole frames instead of stalling navigation, and one
+   that hangs up or errors is dropped */
+class CommandStream {
+    public:
+	static constexpr std::size_t binaryFrameSize{ 88 }; /* Bytes per
+							       binary frame */
+
+	CommandStream(void) noexcept = default;
+	~CommandStream(void);
+	CommandStream(const CommandStream &)		= delete;
+	CommandStream &operator=(const CommandStream &) = delete;
+
+	bool	      open(const std::string &, StreamFormat);
+	void	      close(void) noexcept;
+	bool	      isOpen(void) const noexcept;
+	void	      setBacklogLimit(std::size_t) noexcept;
+	std::size_t   subscribers(void) const noexcept;
+	std::uint64_t dropped(void) const noexcept;
+	void	      publish(const NavCommand &, const json &);
+
+	static std::vector<std::uint8_t> encode(const NavCommand &);
+	static NavCommand decode(const std::uint8_t *) noexcept;
+
+    private:
+	/* Connected subscriber and bytes queued for it */
+	struct Client {
+		int			  fd;
+		std::vector<std::uint8_t> pending;
+	};
+
+	int		    listenFd_{ -1 };		  /* Listening socket */
+	std::string	    path_;			  /* Socket path */
+	StreamFormat	    format_{ StreamFormat::binary }; /* Wire format */
+	std::size_t	    backlogLimit_{ 64 * 1024 }; /* Max queued bytes per
+							   subscriber */
+	std::vector<Client> clients_;		/* Connected subscribers */
+	std::uint64_t	    dropped_{ 0 };	/* Frames missed by slow
+						   subscribers */
+
+	void acceptClients(void);
+	bool flush(Client &);
+};
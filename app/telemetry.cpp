@@ -0,0 +1,266 @@
+#include "telemetry.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "route.hpp"
+
+/* Destructor */
+TelemetryWriter::~TelemetryWriter(void)
+{
+	close();
+}
+
+/* Open telemetry file 'path' for appending, creating it with a header if
+   new */
+/* A partly written trailing record, left by a crash or full disk during
+   flush(), is truncated away so appending resumes on a record boundary.
+   Returns false if the file cannot be opened or is not a telemetry file */
+bool TelemetryWriter::open(const std::filesystem::path &path)
+{
+	close();
+	fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC,
+		     0644);
+	struct stat st {};
+	if (fd_ < 0 || fstat(fd_, &st) < 0) {
+		std::cerr << "Error: cannot open telemetry file " << path
+			  << ".\n";
+		close();
+		return false;
+	}
+	if (!st.st_size) {
+		TelemetryHeader header{ TelemetryHeader::magicValue,
+					TelemetryHeader::versionValue,
+					sizeof(TelemetryRecord), 0 };
+		if (::write(fd_, &header, sizeof(header)) != sizeof(header)) {
+			std::cerr << "Error: cannot write telemetry file "
+				  << path << ".\n";
+			close();
+			return false;
+		}
+	} else if (static_cast<std::size_t>(st.st_size) <
+		   sizeof(TelemetryHeader)) {
+		std::cerr << "Error: " << path << " is not a telemetry file.\n";
+		close();
+		return false;
+	} else if (auto torn{ (st.st_size - sizeof(TelemetryHeader)) %
+			      sizeof(TelemetryRecord) }) {
+		if (ftruncate(fd_, st.st_size - static_cast<off_t>(torn)) < 0) {
+			std::cerr << "Error: cannot truncate telemetry file "
+				  << path << ".\n";
+			close();
+			return false;
+		}
+		std::cerr << "Warning: dropped " << torn
+			  << " bytes of partly written record from " << path
+			  << ".\n";
+	}
+	return true;
+}
+
+/* Flush and close file, if open */
+void TelemetryWriter::close(void) noexcept
+{
+	if (fd_ >= 0) {
+		flush();
+		::close(fd_);
+		fd_ = -1;
+	}
+}
+
+/* Whether file is open */
+bool TelemetryWriter::isOpen(void) const noexcept
+{
+	return fd_ >= 0;
+}
+
+/* Append 'record', writing through at once if it is an event */
+void TelemetryWriter::append(const TelemetryRecord &record) noexcept
+{
+	buffer_[buffered_++] = record;
+	if (buffered_ == batch_ || record.event != TelemetryEvent::tick) {
+		flush();
+	}
+}
+
+/* Write buffered records */
+/* A write cut short leaves a partial record, which readers ignore and the
+   next open() truncates */
+void TelemetryWriter::flush(void) noexcept
+{
+	const auto *bytes{ reinterpret_cast<const char *>(buffer_) };
+	std::size_t left{ buffered_ * sizeof(TelemetryRecord) };
+	while (left) {
+		ssize_t n{ ::write(fd_, bytes, left) };
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			break;
+		}
+		bytes += n;
+		left -= static_cast<std::size_t>(n);
+	}
+	buffered_ = 0;
+}
+
+/* Destructor */
+TelemetryLog::~TelemetryLog(void)
+{
+	close();
+}
+
+/* Map telemetry file 'path' */
+/* Returns false if it is missing or not a telemetry file. A partly written
+   trailing record is ignored */
+bool TelemetryLog::open(const std::filesystem::path &path)
+{
+	close();
+	int fd{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st {};
+	if (fstat(fd, &st) < 0 ||
+	    static_cast<std::size_t>(st.st_size) < sizeof(TelemetryHeader)) {
+		::close(fd);
+		return false;
+	}
+	auto  size{ static_cast<std::size_t>(st.st_size) };
+	void *map{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) };
+	::close(fd);
+	if (map == MAP_FAILED) {
+		return false;
+	}
+	const auto *header{ static_cast<const TelemetryHeader *>(map) };
+	if (header->magic != TelemetryHeader::magicValue ||
+	    header->version != TelemetryHeader::versionValue ||
+	    header->recordSize != sizeof(TelemetryRecord)) {
+		munmap(map, size);
+		return false;
+	}
+	madvise(map, size, MADV_SEQUENTIAL);
+	map_  = map;
+	size_ = size;
+	return true;
+}
+
+/* Unmap file, if open */
+void TelemetryLog::close(void) noexcept
+{
+	if (map_) {
+		munmap(map_, size_);
+		map_  = nullptr;
+		size_ = 0;
+	}
+}
+
+/* Records in file, empty if not open */
+std::span<const TelemetryRecord> TelemetryLog::records(void) const noexcept
+{
+	if (!map_) {
+		return {};
+	}
+	const auto *bytes{ static_cast<const unsigned char *>(map_) };
+	return { reinterpret_cast<const TelemetryRecord *>(
+			 bytes + sizeof(TelemetryHeader)),
+		 (size_ - sizeof(TelemetryHeader)) / sizeof(TelemetryRecord) };
+}
+
+/* Per-leg time, distance travelled and tick latency in one pass over the
+   records */
+/* A leg runs from the first tick toward a destination to its arrival event.
+   A leg cut short by the end of the log is reported as not reached */
+std::vector<LegStats> TelemetryLog::analyze(void) const
+{
+	std::vector<LegStats> legs{};
+	/* Running totals of current leg */
+	LegStats      curr{};
+	bool	      open{ false };
+	std::int64_t  start{ 0 };
+	std::int64_t  last{ 0 };
+	double	      mean{ 0.0 };
+	double	      m2{ 0.0 };
+	const TelemetryRecord *prev{ nullptr };
+	auto finish{ [&](bool reached) {
+		curr.reached	 = reached;
+		curr.time	 = static_cast<double>(last - start) * 1e-9;
+		curr.latencyMean = mean;
+		curr.latencyStd =
+			curr.ticks > 1 ? std::sqrt(m2 / (curr.ticks - 1)) : 0.0;
+		legs.push_back(curr);
+		open = false;
+	} };
+	for (const auto &r : records()) {
+		if (r.event != TelemetryEvent::tick) {
+			if (open && r.event == TelemetryEvent::arrival) {
+				last = r.timestamp;
+				finish(true);
+			}
+			/* Next mission appended to log starts afresh */
+			if (r.event == TelemetryEvent::complete) {
+				prev = nullptr;
+			}
+			continue;
+		}
+		if (open && r.leg != curr.leg) {
+			/* Destination changed without an arrival event */
+			finish(false);
+		}
+		if (!open) {
+			curr  = LegStats{ r.leg, r.waypoint, false, 0, 0.0,
+					  0.0,	 0.0,	     0.0,   0.0 };
+			start = r.timestamp;
+			mean  = 0.0;
+			m2    = 0.0;
+			open  = true;
+		}
+		/* Travel since previous tick counts toward current leg */
+		if (prev) {
+			curr.distance += LegTable::distance(
+				{ prev->latitude, prev->longitude },
+				{ r.latitude, r.longitude });
+		}
+		/* Welford update of latency in microseconds */
+		double us{ static_cast<double>(r.latency) * 1e-3 };
+		curr.ticks++;
+		double delta{ us - mean };
+		mean += delta / static_cast<double>(curr.ticks);
+		m2 += delta * (us - mean);
+		curr.latencyMax = std::max(curr.latencyMax, us);
+		last		= r.timestamp;
+		prev		= &r;
+	}
+	if (open) {
+		finish(false);
+	}
+	return legs;
+}
+
+/* Write 'legs' as CSV to 'out' */
+void TelemetryLog::writeCSV(std::ostream &out, const std::vector<LegStats> &legs)
+{
+	out << "leg,waypoint,reached,ticks,time,distance,latency_mean_us,"
+	       "latency_max_us,latency_std_us\n";
+	for (const auto &l : legs) {
+		out << l.leg << "," << l.waypoint << "," << l.reached << ","
+		    << l.ticks << "," << std::fixed << std::setprecision(3)
+		    << l.time << "," << std::setprecision(1) << l.distance
+		    << "," << std::setprecision(2) << l.latencyMean << ","
+		    << l.latencyMax << "," << l.latencyStd << "\n"
+		    << std::defaultfloat << std::setprecision(6);
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/* Kind of telemetry record */
+enum class TelemetryEvent : std::uint32_t {
+	tick	 = 1, /* Navigation output */
+	arrival	 = 2, /* Waypoint reached */
+	complete = 3  /* Tour completed */
+};
+
+/* Fixed-width telemetry record, one per tick or event */
+struct TelemetryRecord {
+	TelemetryEvent event;	  /* Kind of record */
+	std::uint32_t  leg;	  /* Tour index of next destination, or of
+				     waypoint reached */
+	std::uint64_t  waypoint;  /* CSV index of that waypoint */
+	std::int64_t   timestamp; /* Nanoseconds since Unix epoch */
+	std::int64_t   latency;	  /* Nanoseconds spent producing tick */
+	double	       latitude;  /* Current position */
+	double	       longitude; /* Current position */
+	double	       bearing;	  /* Degrees from true North */
+	double	       distance;  /* Meters to next destination */
+};
+
+static_assert(sizeof(TelemetryRecord) == 64);
+static_assert(std::is_trivially_copyable_v<TelemetryRecord>);
+
+/* Layout of telemetry file: this header, then records back to back */
+struct TelemetryHeader {
+	static constexpr std::uint32_t magicValue{ 0x4c545741 }; /* "AWTL" */
+	static constexpr std::uint32_t versionValue{ 1 };
+
+	std::uint32_t magic;	  /* Identifies file */
+	std::uint32_t version;	  /* Layout version */
+	std::uint32_t recordSize; /* sizeof(TelemetryRecord) */
+	std::uint32_t reserved;	  /* Zero */
+};
+
+/* Append-only writer of binary telemetry. Records are buffered and written
+   in batches, and on every event so that arrivals survive a crash */
+class TelemetryWriter {
+    public:
+	TelemetryWriter(void) noexcept = default;
+	~TelemetryWriter(void);
+	TelemetryWriter(const TelemetryWriter &)	    = delete;
+	TelemetryWriter &operator=(const TelemetryWriter &) = delete;
+
+	bool open(const std::filesystem::path &);
+	void close(void) noexcept;
+	bool isOpen(void) const noexcept;
+	void append(const TelemetryRecord &) noexcept;
+	void flush(void) noexcept;
+
+    private:
+	static constexpr std::size_t batch_{ 64 }; /* Records per write */
+
+	int		fd_{ -1 };	      /* Telemetry file */
+	std::size_t	buffered_{ 0 };	      /* Records in buffer_ */
+	TelemetryRecord buffer_[batch_]{};    /* Records not yet written */
+};
+
+/* Statistics of one leg, from leaving one waypoint to reaching the next */
+struct LegStats {
+	std::uint32_t leg;	   /* Tour index of destination */
+	std::uint64_t waypoint;	   /* CSV index of destination */
+	bool	      reached;	   /* Whether destination was reached */
+	std::size_t   ticks;	   /* Ticks on leg */
+	double	      time;	   /* Seconds on leg */
+	double	      distance;	   /* Meters travelled on leg */
+	double	      latencyMean; /* Mean tick latency in microseconds */
+	double	      latencyMax;  /* Longest tick latency in microseconds */
+	double	      latencyStd;  /* Tick latency standard deviation in
+				      microseconds */
+};
+
+/* Read-only memory-mapped telemetry file */
+class TelemetryLog {
+    public:
+	TelemetryLog(void) noexcept = default;
+	~TelemetryLog(void);
+	TelemetryLog(const TelemetryLog &)	      = delete;
+	TelemetryLog &operator=(const TelemetryLog &) = delete;
+
+	bool				 open(const std::filesystem::path &);
+	void				 close(void) noexcept;
+	std::span<const TelemetryRecord> records(void) const noexcept;
+	std::vector<LegStats>		 analyze(void) const;
+
+	static void writeCSV(std::ostream &, const std::vector<LegStats> &);
+
+    private:
+	void	   *map_{ nullptr }; /* Mapping of file */
+	std::size_t size_{ 0 };	     /* Bytes mapped */
+};
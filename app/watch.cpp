@@ -0,0 +1,203 @@
+#include "watch.hpp"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* Constructor */
+/* Files are reported after 'debounce' without events */
+DirectoryWatcher::DirectoryWatcher(std::chrono::milliseconds debounce) noexcept
+	: fd_{ inotify_init1(IN_NONBLOCK | IN_CLOEXEC) },
+	  debounce_{ debounce }
+{
+}
+
+/* Destructor */
+DirectoryWatcher::~DirectoryWatcher(void)
+{
+	if (fd_ >= 0) {
+		close(fd_);
+	}
+}
+
+/* Start watching files ending in 'extension' in directory 'dir' */
+/* Returns false if the directory cannot be watched */
+bool DirectoryWatcher::watch(const std::filesystem::path &dir,
+			     std::string		  extension)
+{
+	constexpr std::uint32_t mask{ IN_CLOSE_WRITE | IN_MODIFY |
+				      IN_MOVED_TO | IN_DELETE_SELF |
+				      IN_MOVE_SELF | IN_ONLYDIR };
+	if (fd_ < 0 || inotify_add_watch(fd_, dir.c_str(), mask) < 0) {
+		return false;
+	}
+	dir_	   = dir;
+	extension_ = std::move(extension);
+	return true;
+}
+
+/* Block until one or more changed files have settled and return their
+   paths */
+/* Returns an empty list if the directory was removed or moved away, or
+   watching failed */
+std::vector<std::filesystem::path> DirectoryWatcher::wait(void)
+{
+	using namespace std::chrono;
+	std::vector<std::filesystem::path> settled{};
+	while (settled.empty()) {
+		/* Sleep until next file settles, or indefinitely if none
+		   pending */
+		auto now{ steady_clock::now() };
+		int  timeout{ -1 };
+		for (const auto &[name, last] : pending_) {
+			auto left{ duration_cast<milliseconds>(last + debounce_ -
+								now) };
+			int ms{ static_cast<int>(
+				std::max<milliseconds::rep>(left.count(), 0)) };
+			timeout = timeout < 0 ? ms : std::min(timeout, ms);
+		}
+		pollfd pfd{ fd_, POLLIN, 0 };
+		int    ready{ poll(&pfd, 1, timeout) };
+		if (ready < 0 && errno != EINTR) {
+			return {};
+		}
+		if (ready > 0 && !read()) {
+			return {};
+		}
+		/* Collect files quiet for the debounce interval */
+		now = steady_clock::now();
+		std::erase_if(pending_, [&](const auto &entry) {
+			if (now - entry.second < debounce_) {
+				return false;
+			}
+			settled.push_back(dir_ / entry.first);
+			return true;
+		});
+	}
+	std::ranges::sort(settled);
+	return settled;
+}
+
+/* Drain queued events into pending_ */
+/* Returns false if the watch has ended */
+bool DirectoryWatcher::read(void)
+{
+	alignas(inotify_event) char buf[4096];
+	auto now{ std::chrono::steady_clock::now() };
+	while (true) {
+		ssize_t n{ ::read(fd_, buf, sizeof(buf)) };
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return n < 0 && errno == EAGAIN;
+		}
+		for (char *p = buf; p < buf + n;) {
+			const auto *event{ reinterpret_cast<inotify_event *>(p) };
+			p += sizeof(inotify_event) + event->len;
+			if (event->mask &
+			    (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+				return false;
+			}
+			if (event->mask & IN_Q_OVERFLOW) {
+				/* Events were lost, so treat every file as
+				   changed */
+				std::error_code ec{};
+				for (const auto &entry :
+				     std::filesystem::directory_iterator(dir_, ec)) {
+					auto name{ entry.path().filename() };
+					if (name.extension() == extension_) {
+						pending_[name.string()] = now;
+					}
+				}
+				continue;
+			}
+			if (!event->len || event->mask & IN_ISDIR) {
+				continue;
+			}
+			std::filesystem::path name{ event->name };
+			if (name.extension() == extension_) {
+				pending_[name.string()] = now;
+			}
+		}
+	}
+}
+
+/* Constructor */
+/* Runs 'job' on 'threads' workers, or one per core if 0 */
+FilePool::FilePool(Job job, unsigned threads)
+	: job_{ std::move(job) }
+{
+	if (!threads) {
+		threads = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+	for (unsigned i = 0; i < threads; i++) {
+		pool_.emplace_back([this] { work(); });
+	}
+}
+
+/* Destructor */
+/* Waits for running jobs and drops files still queued */
+FilePool::~FilePool(void)
+{
+	{
+		std::lock_guard lock{ mutex_ };
+		stopping_ = true;
+	}
+	ready_.notify_all();
+	pool_.clear(); /* Join workers */
+}
+
+/* Queue 'file', unless it is already waiting */
+void FilePool::submit(const std::filesystem::path &file)
+{
+	{
+		std::lock_guard lock{ mutex_ };
+		if (!queued_.insert(file).second) {
+			return;
+		}
+		queue_.push_back(file);
+	}
+	ready_.notify_one();
+}
+
+/* Worker loop, taking the oldest queued file that is not running */
+void FilePool::work(void)
+{
+	std::unique_lock lock{ mutex_ };
+	while (true) {
+		auto next{ queue_.end() };
+		ready_.wait(lock, [&] {
+			next = std::ranges::find_if(queue_, [&](const auto &f) {
+				return !running_.contains(f);
+			});
+			return stopping_ || next != queue_.end();
+		});
+		if (stopping_) {
+			return;
+		}
+		auto file{ std::move(*next) };
+		queue_.erase(next);
+		queued_.erase(file);
+		running_.insert(file);
+		lock.unlock();
+		job_(file);
+		lock.lock();
+		running_.erase(file);
+		/* A resubmission of this file may now run */
+		ready_.notify_all();
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* Watches a directory with inotify for files of one extension that are
+   written, or moved in, e.g. by an editor saving through a temporary file.
+   Each file is reported once it has had no events for the debounce
+   interval, so a burst of writes yields one report */
+class DirectoryWatcher {
+    public:
+	explicit DirectoryWatcher(std::chrono::milliseconds) noexcept;
+	~DirectoryWatcher(void);
+	DirectoryWatcher(const DirectoryWatcher &)	      = delete;
+	DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+	bool watch(const std::filesystem::path &, std::string);
+	std::vector<std::filesystem::path> wait(void);
+
+    private:
+	int			  fd_{ -1 };  /* inotify instance */
+	std::chrono::milliseconds debounce_;  /* Quiet time before report */
+	std::filesystem::path	  dir_;	      /* Watched directory */
+	std::string		  extension_; /* Extension of watched files,
+						 e.g. ".csv" */
+	std::unordered_map<std::string, std::chrono::steady_clock::time_point>
+		pending_; /* Last event of each unreported file */
+
+	bool read(void);
+};
+
+/* Pool of worker threads running a job on each submitted file. A file
+   submitted while waiting is queued once, and one submitted while its job
+   runs is run again afterwards rather than concurrently, so the last write
+   to a file is always the one processed */
+class FilePool {
+    public:
+	using Job = std::function<void(const std::filesystem::path &)>;
+
+	FilePool(Job, unsigned);
+	~FilePool(void);
+	FilePool(const FilePool &)	      = delete;
+	FilePool &operator=(const FilePool &) = delete;
+
+	void submit(const std::filesystem::path &);
+
+    private:
+	Job				  job_;	    /* Run on each file */
+	std::mutex			  mutex_;   /* Guards members below */
+	std::condition_variable		  ready_;   /* Signals runnable file or
+						       stop */
+	std::deque<std::filesystem::path> queue_;   /* Files waiting, oldest
+						       first */
+	std::set<std::filesystem::path>	  queued_;  /* Files in queue_ */
+	std::set<std::filesystem::path>	  running_; /* Files being run */
+	bool				  stopping_{ false }; /* Flag to
+								 mark workers
+								 must exit */
+	std::vector<std::jthread>	  pool_;    /* Workers */
+
+	void work(void);
+};